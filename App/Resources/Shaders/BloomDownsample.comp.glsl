@@ -0,0 +1,56 @@
+#version 460 core
+
+#include "Common.glslh"
+
+// Halves u_Input into u_Output with a 4x4 tent filter. The first level also keeps only
+// what's brighter than the threshold.
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(binding = 0) uniform sampler2D u_Input;
+layout(r11f_g11f_b10f, binding = 0) writeonly uniform image2D u_Output;
+
+// Input texels under the group's outputs, one texel of border on each side
+const int TileSize = 8 * 2 + 2;
+shared vec3 s_Tile[TileSize * TileSize];
+
+vec3 Prefilter(vec3 color)
+{
+	// Soft knee so brightness just under the threshold fades in instead of popping
+	float knee = u_BloomThreshold * 0.5;
+	float brightness = max(color.r, max(color.g, color.b));
+	float soft = clamp(brightness - u_BloomThreshold + knee, 0.0, 2.0 * knee);
+	soft = soft * soft / (4.0 * knee + 1e-4);
+	return color * (max(soft, brightness - u_BloomThreshold) / max(brightness, 1e-4));
+}
+
+void main()
+{
+	ivec2 inputSize = textureSize(u_Input, 0);
+	ivec2 tileOrigin = ivec2(gl_WorkGroupID.xy) * 16 - 1;
+
+	for (uint i = gl_LocalInvocationIndex; i < TileSize * TileSize; i += 64)
+	{
+		ivec2 coord = clamp(tileOrigin + ivec2(i % TileSize, i / TileSize), ivec2(0), inputSize - 1);
+		vec3 color = texelFetch(u_Input, coord, 0).rgb;
+		s_Tile[i] = u_BloomPrefilter != 0u ? Prefilter(color) : color;
+	}
+
+	barrier();
+
+	ivec2 outputCoord = ivec2(gl_GlobalInvocationID.xy);
+	if (any(greaterThanEqual(outputCoord, imageSize(u_Output))))
+		return;
+
+	const float weights[4] = float[](1.0, 3.0, 3.0, 1.0);
+	ivec2 base = ivec2(gl_LocalInvocationID.xy) * 2;
+
+	vec3 sum = vec3(0.0);
+	for (int y = 0; y < 4; y++)
+	{
+		for (int x = 0; x < 4; x++)
+			sum += s_Tile[(base.y + y) * TileSize + base.x + x] * (weights[x] * weights[y]);
+	}
+
+	imageStore(u_Output, outputCoord, vec4(sum / 64.0, 1.0));
+}
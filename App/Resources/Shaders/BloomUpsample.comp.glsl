@@ -0,0 +1,53 @@
+#version 460 core
+
+// Adds u_Input, the next smaller level, onto u_Output with a 3x3 tent filter
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(binding = 0) uniform sampler2D u_Input;
+layout(r11f_g11f_b10f, binding = 0) uniform image2D u_Output;
+
+// Input texels under the group's outputs, two texels of border below and one above
+const int TileSize = 8;
+shared vec3 s_Tile[TileSize * TileSize];
+
+ivec2 g_TileOrigin;
+
+vec3 Bilinear(vec2 position)
+{
+	vec2 f = fract(position);
+	ivec2 i = ivec2(floor(position)) - g_TileOrigin;
+
+	vec3 a = mix(s_Tile[i.y * TileSize + i.x], s_Tile[i.y * TileSize + i.x + 1], f.x);
+	vec3 b = mix(s_Tile[(i.y + 1) * TileSize + i.x], s_Tile[(i.y + 1) * TileSize + i.x + 1], f.x);
+	return mix(a, b, f.y);
+}
+
+void main()
+{
+	ivec2 inputSize = textureSize(u_Input, 0);
+	ivec2 outputSize = imageSize(u_Output);
+	g_TileOrigin = ivec2(gl_WorkGroupID.xy) * 4 - 2;
+
+	ivec2 coord = clamp(g_TileOrigin + ivec2(gl_LocalInvocationID.xy), ivec2(0), inputSize - 1);
+	s_Tile[gl_LocalInvocationIndex] = texelFetch(u_Input, coord, 0).rgb;
+
+	barrier();
+
+	ivec2 outputCoord = ivec2(gl_GlobalInvocationID.xy);
+	if (any(greaterThanEqual(outputCoord, outputSize)))
+		return;
+
+	// In input texels, relative to their centers
+	vec2 position = (vec2(outputCoord) + 0.5) * (vec2(inputSize) / vec2(outputSize)) - 0.5;
+
+	vec3 sum = vec3(0.0);
+	for (int y = -1; y <= 1; y++)
+	{
+		for (int x = -1; x <= 1; x++)
+			sum += Bilinear(position + vec2(x, y)) * float((2 - abs(x)) * (2 - abs(y)));
+	}
+
+	vec3 color = imageLoad(u_Output, outputCoord).rgb + sum / 16.0;
+	imageStore(u_Output, outputCoord, vec4(color, 1.0));
+}
@@ -0,0 +1,91 @@
+#version 460 core
+
+// FXAA in the style of Timothy Lottes' FXAA 3.11 console version: finds the edge direction
+// from the luma of the diagonal neighbors and blends along it
+
+layout(local_size_x = 16, local_size_y = 16) in;
+
+layout(binding = 0) uniform sampler2D u_Input;
+layout(rgba8, binding = 0) writeonly uniform image2D u_Output;
+
+// Blends reach SpanMax / 2 texels along the edge, plus one for the bilinear footprint
+const float SpanMax = 8.0;
+const int Border = 5;
+const int TileSize = 16 + Border * 2;
+
+// Skips pixels whose neighborhood has less contrast than this
+const float EdgeThreshold = 0.125;
+const float EdgeThresholdMin = 1.0 / 32.0;
+const float ReduceMul = 1.0 / 8.0;
+const float ReduceMin = 1.0 / 128.0;
+
+// rgb and luma
+shared vec4 s_Tile[TileSize * TileSize];
+
+ivec2 g_TileOrigin;
+
+vec4 Load(ivec2 coord)
+{
+	coord -= g_TileOrigin;
+	return s_Tile[coord.y * TileSize + coord.x];
+}
+
+// position in texels, (0.5, 0.5) being the center of the first
+vec4 Bilinear(vec2 position)
+{
+	vec2 t = position - 0.5;
+	vec2 f = fract(t);
+	ivec2 i = ivec2(floor(t));
+
+	vec4 a = mix(Load(i), Load(i + ivec2(1, 0)), f.x);
+	vec4 b = mix(Load(i + ivec2(0, 1)), Load(i + ivec2(1, 1)), f.x);
+	return mix(a, b, f.y);
+}
+
+void main()
+{
+	ivec2 inputSize = textureSize(u_Input, 0);
+	g_TileOrigin = ivec2(gl_WorkGroupID.xy) * 16 - Border;
+
+	for (uint i = gl_LocalInvocationIndex; i < TileSize * TileSize; i += 256)
+	{
+		ivec2 coord = clamp(g_TileOrigin + ivec2(i % TileSize, i / TileSize), ivec2(0), inputSize - 1);
+		vec3 color = texelFetch(u_Input, coord, 0).rgb;
+		s_Tile[i] = vec4(color, dot(color, vec3(0.299, 0.587, 0.114)));
+	}
+
+	barrier();
+
+	ivec2 coord = ivec2(gl_GlobalInvocationID.xy);
+	if (any(greaterThanEqual(coord, imageSize(u_Output))))
+		return;
+
+	vec4 center = Load(coord);
+	float lumaNW = Load(coord + ivec2(-1, -1)).a;
+	float lumaNE = Load(coord + ivec2( 1, -1)).a;
+	float lumaSW = Load(coord + ivec2(-1,  1)).a;
+	float lumaSE = Load(coord + ivec2( 1,  1)).a;
+
+	float lumaMin = min(center.a, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+	float lumaMax = max(center.a, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+	if (lumaMax - lumaMin < max(EdgeThresholdMin, lumaMax * EdgeThreshold))
+	{
+		imageStore(u_Output, coord, vec4(center.rgb, 1.0));
+		return;
+	}
+
+	// Perpendicular to the luma gradient, i.e. along the edge
+	vec2 direction = vec2(-((lumaNW + lumaNE) - (lumaSW + lumaSE)), (lumaNW + lumaSW) - (lumaNE + lumaSE));
+	float reduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * 0.25 * ReduceMul, ReduceMin);
+	direction = clamp(direction / (min(abs(direction.x), abs(direction.y)) + reduce), -SpanMax, SpanMax);
+
+	vec2 position = vec2(coord) + 0.5;
+	vec3 colorA = 0.5 * (Bilinear(position + direction * (1.0 / 3.0 - 0.5)).rgb + Bilinear(position + direction * (2.0 / 3.0 - 0.5)).rgb);
+	vec3 colorB = colorA * 0.5 + 0.25 * (Bilinear(position - direction * 0.5).rgb + Bilinear(position + direction * 0.5).rgb);
+
+	// The wider blend only when it didn't cross into another edge
+	float lumaB = dot(colorB, vec3(0.299, 0.587, 0.114));
+	vec3 color = lumaB < lumaMin || lumaB > lumaMax ? colorA : colorB;
+
+	imageStore(u_Output, coord, vec4(color, 1.0));
+}
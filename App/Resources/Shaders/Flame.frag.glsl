@@ -7,20 +7,15 @@
 layout (location = 0) out vec4 fragColor;
 
 layout(location = 0) in vec2 v_TexCoord;
+layout(location = 1) flat in uint v_DrawIndex;
 
-layout(location = 0) uniform float iTime;
-layout(location = 1) uniform vec2 iResolution;
-layout(location = 2) uniform vec2 flameOrigin;
+#include "Common.glslh"
 
-float noise(vec3 p) //Thx to Las^Mercury
-{
-	vec3 i = floor(p);
-	vec4 a = dot(i, vec3(1., 57., 21.)) + vec4(0., 57., 21., 78.);
-	vec3 f = cos((p-i)*acos(-1.))*(-.5)+.5;
-	a = mix(sin(cos(a)*a),sin(cos(1.+a)*(1.+a)), f.x);
-	a.xy = mix(a.xz, a.yw, f.y);
-	return mix(a.x, a.y, f.z);
-}
+#define iTime u_Time
+// Params.zw is the size of the target, below u_Resolution under dynamic resolution
+#define iResolution u_DrawData[v_DrawIndex].Params.zw
+
+#include "Noise.glslh"
 
 float sphere(vec3 p, vec4 spr)
 {
@@ -66,7 +61,8 @@ void main()
 	vec2 v = -1.0 + 2.0 * fragCoord.xy / iResolution.xy;
 	v.x *= iResolution.x/iResolution.y;
 
-	v += flameOrigin;
+	// Params.xy is the flame's origin
+	v += u_DrawData[v_DrawIndex].Params.xy;
 	
 	vec3 org = vec3(0., -2., 4.);
 	vec3 dir = normalize(vec3(v.x*1.6, -v.y, -1.5));
@@ -3,10 +3,12 @@
 layout(location = 0) in vec2 a_Position;
 layout(location = 1) in vec2 a_TexCoord;
 
-out vec2 v_TexCoord;
+layout(location = 0) out vec2 v_TexCoord;
+layout(location = 1) flat out uint v_DrawIndex;
 
 void main()
 {
 	v_TexCoord = a_TexCoord;
+	v_DrawIndex = gl_BaseInstance;
 	gl_Position = vec4(a_Position, 0.0, 1.0);
 }
\ No newline at end of file
@@ -0,0 +1,28 @@
+#version 460 core
+
+layout(location = 0) out vec4 o_Color;
+
+in vec2 v_TexCoord;
+in vec4 v_Tint;
+flat in uint v_TextureIndex;
+
+layout(binding = 0) uniform sampler2D u_Textures[32];
+
+// Sampler array indices have to be dynamically uniform, which a per-instance index isn't
+#define SAMPLE(i) case i: color = texture(u_Textures[i], v_TexCoord); break;
+
+void main()
+{
+	vec4 color = vec4(1.0);
+	switch (int(v_TextureIndex))
+	{
+		SAMPLE(0)  SAMPLE(1)  SAMPLE(2)  SAMPLE(3)  SAMPLE(4)  SAMPLE(5)  SAMPLE(6)  SAMPLE(7)
+		SAMPLE(8)  SAMPLE(9)  SAMPLE(10) SAMPLE(11) SAMPLE(12) SAMPLE(13) SAMPLE(14) SAMPLE(15)
+		SAMPLE(16) SAMPLE(17) SAMPLE(18) SAMPLE(19) SAMPLE(20) SAMPLE(21) SAMPLE(22) SAMPLE(23)
+		SAMPLE(24) SAMPLE(25) SAMPLE(26) SAMPLE(27) SAMPLE(28) SAMPLE(29) SAMPLE(30) SAMPLE(31)
+	}
+
+	o_Color = color * v_Tint;
+	if (o_Color.a == 0.0)
+		discard;
+}
@@ -0,0 +1,26 @@
+#version 460 core
+
+#include "Common.glslh"
+
+// Per instance, see Renderer2D.cpp
+layout(location = 0) in vec4 a_Basis; // 2D transform columns: x axis in xy, y axis in zw
+layout(location = 1) in vec2 a_Translation;
+layout(location = 2) in vec4 a_Tint;
+layout(location = 3) in uint a_TextureIndex;
+layout(location = 4) in vec4 a_UVRect; // min uv in xy, max uv in zw
+
+out vec2 v_TexCoord;
+out vec4 v_Tint;
+flat out uint v_TextureIndex;
+
+void main()
+{
+	// Triangle strip corners: (0,0) (1,0) (0,1) (1,1)
+	vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+	vec2 position = a_Basis.xy * (corner.x - 0.5) + a_Basis.zw * (corner.y - 0.5) + a_Translation;
+
+	v_TexCoord = mix(a_UVRect.xy, a_UVRect.zw, corner);
+	v_Tint = a_Tint;
+	v_TextureIndex = a_TextureIndex;
+	gl_Position = u_ViewProjection * vec4(position, 0.0, 1.0);
+}
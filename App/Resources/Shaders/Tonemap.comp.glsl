@@ -0,0 +1,37 @@
+#version 460 core
+
+// Adds the bloom to the scene and maps it from HDR into u_Output
+
+#include "Common.glslh"
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(binding = 0) uniform sampler2D u_Scene;
+layout(binding = 1) uniform sampler2D u_Bloom;
+layout(rgba8, binding = 0) writeonly uniform image2D u_Output;
+
+// Krzysztof Narkowicz's fit of the ACES filmic curve
+vec3 ACESFilm(vec3 x)
+{
+	const float a = 2.51, b = 0.03, c = 2.43, d = 0.59, e = 0.14;
+	return clamp((x * (a * x + b)) / (x * (c * x + d) + e), 0.0, 1.0);
+}
+
+void main()
+{
+	ivec2 outputCoord = ivec2(gl_GlobalInvocationID.xy);
+	ivec2 outputSize = imageSize(u_Output);
+	if (any(greaterThanEqual(outputCoord, outputSize)))
+		return;
+
+	vec3 color = texelFetch(u_Scene, outputCoord, 0).rgb;
+
+	// Bloom is smaller than the scene, the sampler filters it
+	if (u_BloomIntensity > 0.0)
+		color += textureLod(u_Bloom, (vec2(outputCoord) + 0.5) / vec2(outputSize), 0.0).rgb * u_BloomIntensity;
+
+	if (u_Tonemap != 0u)
+		color = ACESFilm(color * u_Exposure);
+
+	imageStore(u_Output, outputCoord, vec4(color, 1.0));
+}
@@ -4,8 +4,13 @@
 
 #include "Core/Application.h"
 
+#include "Core/Renderer/DynamicResolution.h"
 #include "Core/Renderer/Renderer.h"
+#include "Core/Renderer/RenderCommandQueue.h"
+#include "Core/Renderer/RenderState.h"
 #include "Core/Renderer/Shader.h"
+#include "Core/Renderer/ShaderHotReload.h"
+#include "Core/Renderer/UniformBuffers.h"
 
 #include <glm/glm.hpp>
 
@@ -15,55 +20,68 @@ AppLayer::AppLayer()
 {
 	std::println("Created new AppLayer!");
 
-	// Create shaders
-	m_Shader = Renderer::CreateGraphicsShader("Resources/Shaders/Fullscreen.vert.glsl", "Resources/Shaders/Flame.frag.glsl");
+	SetEventCategories(Core::EventCategoryMouse | Core::EventCategoryApplication);
 
-	// Create geometry
-	glCreateVertexArrays(1, &m_VertexArray);
-	glCreateBuffers(1, &m_VertexBuffer);
+	// Edits to the shader files swap m_Shader in place on the GL thread
+	Renderer::WatchGraphicsShader(&m_Shader, "Resources/Shaders/Fullscreen.vert.glsl", "Resources/Shaders/Flame.frag.glsl");
 
-	struct Vertex
+	// GL objects are created on whichever thread owns the context
+	Renderer::Submit([this]()
 	{
-		glm::vec2 Position;
-		glm::vec2 TexCoord;
-	};
-
-	Vertex vertices[] = {
-		{ {-1.0f, -1.0f }, { 0.0f, 0.0f } },  // Bottom-left
-		{ { 3.0f, -1.0f }, { 2.0f, 0.0f } },  // Bottom-right
-		{ {-1.0f,  3.0f }, { 0.0f, 2.0f } }   // Top-left
-	};
-
-	glNamedBufferData(m_VertexBuffer, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-	// Bind the VBO to VAO at binding index 0
-	glVertexArrayVertexBuffer(m_VertexArray, 0, m_VertexBuffer, 0, sizeof(Vertex));
-
-	// Enable attributes
-	glEnableVertexArrayAttrib(m_VertexArray, 0); // position
-	glEnableVertexArrayAttrib(m_VertexArray, 1); // uv
-
-	// Format: location, size, type, normalized, relative offset
-	glVertexArrayAttribFormat(m_VertexArray, 0, 2, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(Vertex, Position)));
-	glVertexArrayAttribFormat(m_VertexArray, 1, 2, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(Vertex, TexCoord)));
-
-	// Link attribute locations to binding index 0
-	glVertexArrayAttribBinding(m_VertexArray, 0, 0);
-	glVertexArrayAttribBinding(m_VertexArray, 1, 0);
+		// Create shaders
+		m_Shader = Renderer::CreateGraphicsShader("Resources/Shaders/Fullscreen.vert.glsl", "Resources/Shaders/Flame.frag.glsl");
+
+		// Create geometry
+		glCreateVertexArrays(1, &m_VertexArray);
+		glCreateBuffers(1, &m_VertexBuffer);
+
+		struct Vertex
+		{
+			glm::vec2 Position;
+			glm::vec2 TexCoord;
+		};
+
+		Vertex vertices[] = {
+			{ {-1.0f, -1.0f }, { 0.0f, 0.0f } },  // Bottom-left
+			{ { 3.0f, -1.0f }, { 2.0f, 0.0f } },  // Bottom-right
+			{ {-1.0f,  3.0f }, { 0.0f, 2.0f } }   // Top-left
+		};
+
+		glNamedBufferData(m_VertexBuffer, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+		// Bind the VBO to VAO at binding index 0
+		glVertexArrayVertexBuffer(m_VertexArray, 0, m_VertexBuffer, 0, sizeof(Vertex));
+
+		// Enable attributes
+		glEnableVertexArrayAttrib(m_VertexArray, 0); // position
+		glEnableVertexArrayAttrib(m_VertexArray, 1); // uv
+
+		// Format: location, size, type, normalized, relative offset
+		glVertexArrayAttribFormat(m_VertexArray, 0, 2, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(Vertex, Position)));
+		glVertexArrayAttribFormat(m_VertexArray, 1, 2, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(Vertex, TexCoord)));
+
+		// Link attribute locations to binding index 0
+		glVertexArrayAttribBinding(m_VertexArray, 0, 0);
+		glVertexArrayAttribBinding(m_VertexArray, 1, 0);
+	});
 }
 
 AppLayer::~AppLayer()
 {
-	glDeleteVertexArrays(1, &m_VertexArray);
-	glDeleteBuffers(1, &m_VertexBuffer);
+	// Also orders the read of m_Shader below after any reload that swapped it
+	Renderer::UnwatchShader(&m_Shader);
 
-	glDeleteProgram(m_Shader);
+	Renderer::Submit([vertexArray = m_VertexArray, vertexBuffer = m_VertexBuffer, shader = m_Shader]()
+	{
+		glDeleteVertexArrays(1, &vertexArray);
+		glDeleteBuffers(1, &vertexBuffer);
+
+		glDeleteProgram(shader);
+	});
 }
 
 void AppLayer::OnEvent(Core::Event& event)
 {
-	std::println("{}", event.ToString());
-
 	Core::EventDispatcher dispatcher(event);
 	dispatcher.Dispatch<Core::MouseButtonPressedEvent>([this](Core::MouseButtonPressedEvent& e) { return OnMouseButtonPressed(e); });
 	dispatcher.Dispatch<Core::MouseMovedEvent>([this](Core::MouseMovedEvent& e) { return OnMouseMoved(e); });
@@ -72,8 +90,6 @@ void AppLayer::OnEvent(Core::Event& event)
 
 void AppLayer::OnUpdate(float ts)
 {
-	m_Time += ts;
-
 	if (glfwGetKey(Core::Application::Get().GetWindow()->GetHandle(), GLFW_KEY_1) == GLFW_PRESS)
 	{
 		TransitionTo<VoidLayer>();
@@ -82,25 +98,49 @@ void AppLayer::OnUpdate(float ts)
 
 void AppLayer::OnRender()
 {
-	glUseProgram(m_Shader);
+	Core::Application& application = Core::Application::Get();
+	Renderer::FrameGraph& frameGraph = application.GetFrameGraph();
+	const Renderer::FrameGraphResource sceneColor = application.GetSceneColor();
+
+	// The raymarch costs the same per pixel, so it renders at the dynamic resolution scale.
+	// At full scale it goes straight into Scene Color.
+	Renderer::FrameGraphTextureDesc flameDesc = frameGraph.GetDesc(sceneColor);
+	const glm::uvec2 flameSize = application.GetDynamicResolution().GetScaledSize({ flameDesc.Width, flameDesc.Height });
+	const bool scaled = flameSize != glm::uvec2(flameDesc.Width, flameDesc.Height);
+	flameDesc.Width = flameSize.x;
+	flameDesc.Height = flameSize.y;
+	const Renderer::FrameGraphResource flameColor = scaled ? frameGraph.CreateTexture("Flame Color", flameDesc) : sceneColor;
+
+	frameGraph.AddPass("Flame", [flameColor](Renderer::FrameGraphBuilder& builder)
+	{
+		builder.Write(flameColor);
+	},
+	[this, flameColor, flamePosition = m_FlamePosition](const Renderer::FrameGraphPassResources& resources)
+	{
+		const Renderer::FrameGraphTextureDesc& target = resources.GetDesc(flameColor);
 
-	// Uniforms
-	glUniform1f(0, m_Time);
+		// Time comes from the frame block, the resolution is the scaled target's
+		Renderer::DrawData drawData;
+		drawData.Params = glm::vec4(flamePosition, (float)target.Width, (float)target.Height);
+		const uint32_t drawIndex = Renderer::PushDrawData(drawData);
 
-	glm::vec2 framebufferSize = Core::Application::Get().GetFramebufferSize();
-	glUniform2f(1, framebufferSize.x, framebufferSize.y);
+		Renderer::RenderState::UseProgram(m_Shader);
 
-	glUniform2f(2, m_FlamePosition.x, m_FlamePosition.y);
+		Renderer::RenderState::BindFramebuffer(GL_FRAMEBUFFER, resources.GetFramebuffer());
+		Renderer::RenderState::SetViewport(0, 0, target.Width, target.Height);
+		Renderer::RenderState::SetBlend(false);
+		Renderer::RenderState::SetDepthTest(false);
 
-	glViewport(0, 0, static_cast<GLsizei>(framebufferSize.x), static_cast<GLsizei>(framebufferSize.y));
+		// Render
+		Renderer::RenderState::SetClearColor({ 0.0f, 0.0f, 0.0f, 1.0f });
+		glClear(GL_COLOR_BUFFER_BIT);
 
-	// Render
-	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-	glClear(GL_COLOR_BUFFER_BIT);
+		Renderer::RenderState::BindVertexArray(m_VertexArray);
+		glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, 3, 1, drawIndex);
+	});
 
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
-	glBindVertexArray(m_VertexArray);
-	glDrawArrays(GL_TRIANGLES, 0, 3);
+	if (scaled)
+		Renderer::AddUpscalePass(frameGraph, flameColor, sceneColor);
 }
 
 bool AppLayer::OnMouseButtonPressed(Core::MouseButtonPressedEvent& event)
@@ -27,7 +27,6 @@ private:
 	uint32_t m_VertexArray = 0;
 	uint32_t m_VertexBuffer = 0;
 
-	float m_Time = 0.0f;
 	glm::vec2 m_MousePosition{ 0.0f };
 	glm::vec2 m_FlamePosition{ 0.0f };
 };
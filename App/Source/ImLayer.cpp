@@ -2,7 +2,10 @@
 
 #include "Core/Application.h"
 #include "Core/Renderer/Renderer.h"
+#include "Core/Renderer/RenderCommandQueue.h"
+#include "Core/Renderer/RenderState.h"
 
+#include "Core/Debug/GPUProfiler.h"
 #include "Core/Debug/Profiler.h"
 
 #include <imgui.h>
@@ -15,6 +18,7 @@ namespace Core
 	ImLayer::ImLayer()
 		: Layer("ImLayer")
 	{
+		SetEventCategories(EventCategoryKeyboard | EventCategoryMouseButton);
 	}
 
 	void ImLayer::OnAttach()
@@ -39,7 +43,7 @@ namespace Core
 
 		auto size = Core::Application::Get().GetFramebufferSize();
 
-		Renderer::BeginFrame((int)size.x, (int)size.y);
+		Renderer::Submit([size]() { Renderer::BeginFrame((int)size.x, (int)size.y); });
 	}
 
 	void ImLayer::OnImGuiRender()
@@ -165,6 +169,48 @@ namespace Core
 			ImGui::Separator();
 			ImGui::Text("FPS: %.1f (%.2f ms)", io.Framerate, (io.Framerate > 0.0f) ? (1000.0f / io.Framerate) : 0.0f);
 			ImGui::Text("Clicks: %d", m_Clicks);
+
+			const Renderer::RenderStateStats stateStats = Renderer::RenderState::GetLastFrameStats();
+			ImGui::Text("GL state calls: %u, %u redundant skipped", stateStats.Calls, stateStats.Redundant);
+
+			Renderer::DynamicResolution& dynamicResolution = Core::Application::Get().GetDynamicResolution();
+			Renderer::DynamicResolutionSettings resolutionSettings = dynamicResolution.GetSettings();
+			if (ImGui::Checkbox("Dynamic resolution", &resolutionSettings.Enabled))
+				dynamicResolution.SetSettings(resolutionSettings);
+			ImGui::Text("Render scale: %.0f%%, GPU %.2f ms (target %.2f ms)", dynamicResolution.GetScale() * 100.0f,
+				dynamicResolution.GetAverageGPUMillis(), resolutionSettings.TargetGPUMillis);
+
+			Renderer::PostProcessSettings& postProcess = Core::Application::Get().GetPostProcessSettings();
+			ImGui::Checkbox("Bloom", &postProcess.Bloom);
+			ImGui::SameLine();
+			ImGui::Checkbox("Tonemap", &postProcess.Tonemap);
+			ImGui::SameLine();
+			ImGui::Checkbox("FXAA", &postProcess.FXAA);
+
+			const Renderer::FrameGraphStats& graphStats = Core::Application::Get().GetFrameGraphStats();
+			ImGui::Text("Frame graph: %u passes, %u culled, %u barriers", graphStats.Passes, graphStats.CulledPasses, graphStats.Barriers);
+			ImGui::Text("Transients: %u in %u textures, %.1f MB (%.1f MB unaliased)", graphStats.TransientResources, graphStats.TransientTextures,
+				graphStats.TransientBytes / (1024.0 * 1024.0), graphStats.UnaliasedBytes / (1024.0 * 1024.0));
+
+			const std::vector<GPUPassTiming> passes = GetGPUPassTimings();
+			if (!passes.empty() && ImGui::BeginTable("GPU Passes", 4, ImGuiTableFlags_SizingFixedFit))
+			{
+				ImGui::TableSetupColumn("GPU pass");
+				ImGui::TableSetupColumn("ms");
+				ImGui::TableSetupColumn("avg");
+				ImGui::TableSetupColumn("max");
+				ImGui::TableHeadersRow();
+
+				for (const GPUPassTiming& pass : passes)
+				{
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn(); ImGui::TextUnformatted(pass.Name);
+					ImGui::TableNextColumn(); ImGui::Text("%.3f", pass.LastMillis);
+					ImGui::TableNextColumn(); ImGui::Text("%.3f", pass.AverageMillis);
+					ImGui::TableNextColumn(); ImGui::Text("%.3f", pass.MaxMillis);
+				}
+				ImGui::EndTable();
+			}
 		}
 		ImGui::End();
 	}
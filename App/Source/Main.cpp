@@ -1,19 +1,111 @@
 #include "Core/Application.h"
+#include "Core/Debug/BenchmarkReport.h"
 
 #include "AppLayer.h"
 #include "OverlayLayer.h"
 #include "ImLayer.h"
 
-int main()
+#include <cstdlib>
+#include <iostream>
+#include <print>
+#include <string>
+#include <string_view>
+
+int main(int argc, char** argv)
 {
 	Core::ApplicationSpecification appSpec;
 	appSpec.Name = "Architecture";
 	appSpec.WindowSpec.Width = 1920;
 	appSpec.WindowSpec.Height = 1080;
 
+	// --benchmark <flame|overlay|imgui> runs a fixed scenario and reports its frame times
+	std::string benchmark;
+	uint64_t warmupFrames = 100;
+	std::string benchmarkOutput;
+	std::string thresholdsPath;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string_view arg = argv[i];
+		if (arg == "--headless")
+			appSpec.Headless = true;
+		else if (arg == "--frames" && i + 1 < argc)
+			appSpec.FrameCount = std::strtoull(argv[++i], nullptr, 10);
+		else if (arg == "--benchmark" && i + 1 < argc)
+			benchmark = argv[++i];
+		else if (arg == "--warmup" && i + 1 < argc)
+			warmupFrames = std::strtoull(argv[++i], nullptr, 10);
+		else if (arg == "--output" && i + 1 < argc)
+			benchmarkOutput = argv[++i];
+		else if (arg == "--thresholds" && i + 1 < argc)
+			thresholdsPath = argv[++i];
+	}
+
+	if (!benchmark.empty())
+	{
+		if (benchmark != "flame" && benchmark != "overlay" && benchmark != "imgui")
+		{
+			std::cerr << "Unknown benchmark scenario '" << benchmark << "', expected flame, overlay or imgui" << std::endl;
+			return 1;
+		}
+
+		// Measured frames, the warm-up comes on top
+		const uint64_t measuredFrames = appSpec.FrameCount > 0 ? appSpec.FrameCount : 1000;
+		appSpec.FrameCount = warmupFrames + measuredFrames;
+		appSpec.FrameTimingHistory = appSpec.FrameCount;
+		// Frame times are only comparable between runs at the same resolution
+		appSpec.DynamicResolution.Enabled = false;
+
+		if (benchmarkOutput.empty())
+			benchmarkOutput = "Benchmarks/" + benchmark;
+	}
+
+	// Headless runs need an end
+	if (appSpec.Headless && appSpec.FrameCount == 0)
+		appSpec.FrameCount = 1000;
+
 	Core::Application application(appSpec);
-	//application.PushLayer<AppLayer>();
-	//application.PushLayer<OverlayLayer>();
-	application.PushLayer<Core::ImLayer>();
+
+	if (benchmark == "flame")
+	{
+		application.PushLayer<AppLayer>();
+	}
+	else if (benchmark == "overlay")
+	{
+		application.PushLayer<AppLayer>();
+		application.PushLayer<OverlayLayer>();
+	}
+	else
+	{
+		//application.PushLayer<AppLayer>();
+		//application.PushLayer<OverlayLayer>();
+		application.PushLayer<Core::ImLayer>();
+	}
+
 	application.Run();
+
+	if (benchmark.empty())
+		return 0;
+
+	Core::BenchmarkReport report = Core::CreateBenchmarkReport(benchmark, application.GetFrameProfiler().GetHistory(), warmupFrames);
+	Core::WriteBenchmarkJson(report, benchmarkOutput + ".json");
+	Core::WriteBenchmarkCsv(report, benchmarkOutput + ".csv");
+
+	std::println("[Benchmark] {}: {} frames after {} warm-up", benchmark, report.Frames.size(), warmupFrames);
+	std::println("[Benchmark]   CPU ms: mean {:.3f}  p50 {:.3f}  p95 {:.3f}  p99 {:.3f}  max {:.3f}",
+		report.CPU.Mean, report.CPU.P50, report.CPU.P95, report.CPU.P99, report.CPU.Max);
+	if (report.HasGPU)
+	{
+		std::println("[Benchmark]   GPU ms: mean {:.3f}  p50 {:.3f}  p95 {:.3f}  p99 {:.3f}  max {:.3f}",
+			report.GPU.Mean, report.GPU.P50, report.GPU.P95, report.GPU.P99, report.GPU.Max);
+	}
+
+	if (thresholdsPath.empty())
+		return 0;
+
+	std::vector<std::string> violations = Core::CheckBenchmarkThresholds(report, thresholdsPath);
+	for (const std::string& violation : violations)
+		std::cerr << "[Benchmark] Regression: " << violation << std::endl;
+
+	return violations.empty() ? 0 : 1;
 }
@@ -2,10 +2,11 @@
 
 #include "Core/Application.h"
 
-#include "Core/Renderer/Shader.h"
+#include "Core/Renderer/RenderCommandQueue.h"
+#include "Core/Renderer/Renderer2D.h"
+#include "Core/Renderer/TextureStreaming.h"
 
 #include <glm/glm.hpp>
-#include <glm/gtc/type_ptr.hpp>
 
 #include "AppLayer.h"
 #include "VoidLayer.h"
@@ -16,59 +17,21 @@ OverlayLayer::OverlayLayer()
 {
 	std::println("Created new OverlayLayer!");
 
-	// Create shaders
-	m_Shader = Renderer::CreateGraphicsShader("Resources/Shaders/Transform.vert.glsl", "Resources/Shaders/Texture.frag.glsl");
+	SetEventCategories(Core::EventCategoryMouseButton);
 
-	// Create geometry
-	glCreateVertexArrays(1, &m_VertexArray);
-	glCreateBuffers(1, &m_VertexBuffer);
-	glCreateBuffers(1, &m_IndexBuffer);
-
-	struct Vertex
+	// GL objects are created on whichever thread owns the context
+	Renderer::Submit([this]()
 	{
-		glm::vec2 Position;
-		glm::vec2 TexCoord;
-	};
-
-	Vertex vertices[] = {
-		{ {-0.5f, -0.5f }, { 0.0f, 0.0f } }, // Bottom-left
-		{ { 0.5f, -0.5f }, { 1.0f, 0.0f } }, // Bottom-right
-		{ { 0.5f,  0.5f }, { 1.0f, 1.0f } }, // Top-right
-		{ {-0.5f,  0.5f }, { 0.0f, 1.0f } }  // Top-left
-	};
-
-	glNamedBufferData(m_VertexBuffer, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-	uint32_t indices[] = { 0, 1, 2, 2, 3, 0 };
-	glNamedBufferData(m_IndexBuffer, sizeof(indices), indices, GL_STATIC_DRAW);
-
-	// Bind the VBO to VAO at binding index 0
-	glVertexArrayVertexBuffer(m_VertexArray, 0, m_VertexBuffer, 0, sizeof(Vertex));
-	glVertexArrayElementBuffer(m_VertexArray, m_IndexBuffer);
-
-	// Enable attributes
-	glEnableVertexArrayAttrib(m_VertexArray, 0); // position
-	glEnableVertexArrayAttrib(m_VertexArray, 1); // uv
-
-	// Format: location, size, type, normalized, relative offset
-	glVertexArrayAttribFormat(m_VertexArray, 0, 2, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(Vertex, Position)));
-	glVertexArrayAttribFormat(m_VertexArray, 1, 2, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(Vertex, TexCoord)));
-
-	// Link attribute locations to binding index 0
-	glVertexArrayAttribBinding(m_VertexArray, 0, 0);
-	glVertexArrayAttribBinding(m_VertexArray, 1, 0);
-
-	m_Texture = Renderer::LoadTexture("Resources/Textures/Button.png");
+		m_Texture = Renderer::LoadTextureAsync("Resources/Textures/Button.png").Handle;
+	});
 }
 
 OverlayLayer::~OverlayLayer()
 {
-	glDeleteVertexArrays(1, &m_VertexArray);
-	glDeleteBuffers(1, &m_VertexBuffer);
-
-	glDeleteProgram(m_Shader);
-
-	glDeleteTextures(1, &m_Texture.Handle);
+	Renderer::Submit([texture = m_Texture.load()]()
+	{
+		glDeleteTextures(1, &texture);
+	});
 }
 
 void OverlayLayer::OnEvent(Core::Event& event)
@@ -103,25 +66,20 @@ void OverlayLayer::OnUpdate(float ts)
 
 void OverlayLayer::OnRender()
 {
-	glUseProgram(m_Shader);
+	// Until the GL thread has created it
+	const GLuint texture = m_Texture;
+	if (!texture)
+		return;
 
-	// Uniforms
-	glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(-0.8f, -0.75f, 0.0f)) * glm::scale(glm::mat4(1.0f), glm::vec3(0.2604f, 0.2222f, 1.0f));
-	glUniformMatrix4fv(0, 1, GL_FALSE, glm::value_ptr(transform));
-	glUniform1i(1, 0); // Texture
-	glUniform1i(2, (int)m_IsHovered);
+	Core::Application& application = Core::Application::Get();
 
-	glBindTextureUnit(0, m_Texture.Handle);
+	// Dimmed until hovered
+	const glm::vec4 tint = m_IsHovered ? glm::vec4(1.0f) : glm::vec4(0.8f, 0.8f, 0.8f, 1.0f);
 
-	glm::vec2 framebufferSize = Core::Application::Get().GetFramebufferSize();
-	glViewport(0, 0, static_cast<GLsizei>(framebufferSize.x), static_cast<GLsizei>(framebufferSize.y));
-
-	// Render
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glBindVertexArray(m_VertexArray);
-	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+	// Blends onto what the layers below drew, in clip space
+	Renderer::BeginScene2D(glm::mat4(1.0f));
+	Renderer::DrawQuad(glm::vec2(-0.8f, -0.75f), glm::vec2(0.2604f, 0.2222f), texture, tint);
+	Renderer::EndScene2D(application.GetFrameGraph(), application.GetSceneColor());
 }
 
 bool OverlayLayer::IsButtonHovered() const
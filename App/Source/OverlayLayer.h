@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <stdint.h>
 
 #include "Core/Layer.h"
@@ -22,11 +23,8 @@ private:
 
 	bool OnMouseButtonPressed(Core::MouseButtonPressedEvent& event);
 private:
-	uint32_t m_Shader = 0;
-	uint32_t m_VertexArray = 0;
-	uint32_t m_VertexBuffer = 0;
-	uint32_t m_IndexBuffer = 0;
-	Renderer::Texture m_Texture;
+	// Created on the GL thread, read while recording
+	std::atomic<GLuint> m_Texture = 0;
 
 	bool m_IsHovered = false;
 	bool m_Pressed = true;
@@ -3,7 +3,8 @@
 #include "AppLayer.h"
 
 #include "Core/Application.h"
-#include "Core/Renderer/Renderer.h"
+#include "Core/Renderer/FrameGraph.h"
+#include "Core/Renderer/RenderState.h"
 
 void VoidLayer::OnUpdate(float ts)
 {
@@ -15,6 +16,20 @@ void VoidLayer::OnUpdate(float ts)
 
 void VoidLayer::OnRender()
 {
-	glClearColor(0.6f, 0.1f, 0.2f, 1.0f);
-	glClear(GL_COLOR_BUFFER_BIT);
+	Core::Application& application = Core::Application::Get();
+	const Renderer::FrameGraphResource sceneColor = application.GetSceneColor();
+
+	application.GetFrameGraph().AddPass("Void", [sceneColor](Renderer::FrameGraphBuilder& builder)
+	{
+		builder.Write(sceneColor);
+	},
+	[sceneColor](const Renderer::FrameGraphPassResources& resources)
+	{
+		const Renderer::FrameGraphTextureDesc& target = resources.GetDesc(sceneColor);
+
+		Renderer::RenderState::BindFramebuffer(GL_FRAMEBUFFER, resources.GetFramebuffer());
+		Renderer::RenderState::SetViewport(0, 0, target.Width, target.Height);
+		Renderer::RenderState::SetClearColor({ 0.6f, 0.1f, 0.2f, 1.0f });
+		glClear(GL_COLOR_BUFFER_BIT);
+	});
 }
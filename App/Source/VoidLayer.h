@@ -5,7 +5,7 @@
 class VoidLayer : public Core::Layer
 {
 public:
-	VoidLayer() {}
+	VoidLayer() { SetEventCategories(Core::EventCategoryNone); }
 	virtual ~VoidLayer() {}
 
 	virtual void OnUpdate(float ts) override;
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <stdint.h>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace Benchmark {
+
+	class Timer
+	{
+	public:
+		Timer() { Reset(); }
+
+		void Reset() { m_Start = std::chrono::steady_clock::now(); }
+
+		double ElapsedMillis() const
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_Start).count();
+		}
+	private:
+		std::chrono::steady_clock::time_point m_Start;
+	};
+
+	// Runs func warmup + iterations times and returns the median of the measured runs in ms
+	template<typename Func>
+	double MeasureMedianMillis(uint32_t warmup, uint32_t iterations, Func&& func)
+	{
+		for (uint32_t i = 0; i < warmup; i++)
+			func();
+
+		std::vector<double> samples(iterations);
+		for (uint32_t i = 0; i < iterations; i++)
+		{
+			Timer timer;
+			func();
+			samples[i] = timer.ElapsedMillis();
+		}
+
+		std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+		return samples[samples.size() / 2];
+	}
+
+	// Keeps the optimizer from discarding work whose result is otherwise unused: value's address
+	// escapes and memory is clobbered, so every write to it has to have happened
+	template<typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		static const void* volatile s_Sink = nullptr;
+		s_Sink = &value;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r"(&value) : "memory");
+#endif
+	}
+
+	bool RunJobSystemBenchmark();
+	bool RunEventDispatchBenchmark();
+	bool RunRenderer2DBenchmark();
+	bool RunFramebufferBenchmark();
+	bool RunFrameGraphBenchmark();
+	bool RunTransformBenchmark();
+
+}
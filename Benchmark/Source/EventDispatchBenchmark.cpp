@@ -0,0 +1,140 @@
+#include "Benchmark.h"
+
+#include "Core/InputEvents.h"
+#include "Core/Layer.h"
+#include "Core/WindowEvents.h"
+
+#include <functional>
+#include <memory>
+#include <print>
+#include <ranges>
+#include <vector>
+
+namespace Benchmark {
+
+	// The dispatcher as it was before it took callables directly, kept for comparison
+	class LegacyEventDispatcher
+	{
+		template<typename T>
+		using EventFn = std::function<bool(T&)>;
+	public:
+		LegacyEventDispatcher(Core::Event& event)
+			: m_Event(event) {
+		}
+
+		template<typename T>
+		bool Dispatch(EventFn<T> func)
+		{
+			if (m_Event.GetEventType() == T::GetStaticType() && !m_Event.Handled)
+			{
+				m_Event.Handled = func(*(T*)&m_Event);
+				return true;
+			}
+			return false;
+		}
+	private:
+		Core::Event& m_Event;
+	};
+
+	// Handles a couple of event types like the App layers do, counting what it sees
+	template<typename DispatcherT>
+	class InputLayer : public Core::Layer
+	{
+	public:
+		InputLayer(int categories)
+			: Layer("InputLayer")
+		{
+			SetEventCategories(categories);
+		}
+
+		virtual void OnEvent(Core::Event& event) override
+		{
+			DispatcherT dispatcher(event);
+			dispatcher.template Dispatch<Core::KeyPressedEvent>([this](Core::KeyPressedEvent& e) { m_Keys += e.GetKeyCode(); return false; });
+			dispatcher.template Dispatch<Core::MouseButtonPressedEvent>([this](Core::MouseButtonPressedEvent& e) { m_Buttons += e.GetMouseButton(); return false; });
+			dispatcher.template Dispatch<Core::WindowResizeEvent>([this](Core::WindowResizeEvent& e) { m_Resizes += e.GetWidth(); return false; });
+			DoNotOptimize(m_Keys);
+		}
+	private:
+		uint64_t m_Keys = 0;
+		uint64_t m_Buttons = 0;
+		uint64_t m_Resizes = 0;
+	};
+
+	// Application::RaiseEvent, with and without category filtering
+	template<bool Filter>
+	static void RaiseEvent(const std::vector<std::unique_ptr<Core::Layer>>& layers, Core::Event& event)
+	{
+		for (auto& layer : std::views::reverse(layers))
+		{
+			if (Filter && !layer->IsSubscribedTo(event))
+				continue;
+
+			layer->OnEvent(event);
+			if (event.Handled)
+				break;
+		}
+	}
+
+	template<typename DispatcherT>
+	static std::vector<std::unique_ptr<Core::Layer>> CreateLayers()
+	{
+		std::vector<std::unique_ptr<Core::Layer>> layers;
+		for (int i = 0; i < 8; i++)
+		{
+			// A mix of keyboard-only, button-only and window layers, none interested in mouse motion
+			int categories = i % 3 == 0 ? Core::EventCategoryKeyboard
+				: i % 3 == 1 ? Core::EventCategoryMouseButton
+				: Core::EventCategoryApplication;
+			layers.push_back(std::make_unique<InputLayer<DispatcherT>>(categories));
+		}
+		return layers;
+	}
+
+	bool RunEventDispatchBenchmark()
+	{
+		constexpr uint32_t EventCount = 100'000;
+
+		// Roughly what a high polling rate mouse produces: mostly motion, some clicks and keys
+		std::vector<std::unique_ptr<Core::Event>> events;
+		for (uint32_t i = 0; i < EventCount; i++)
+		{
+			if (i % 50 == 0)
+				events.push_back(std::make_unique<Core::KeyPressedEvent>(65 + i % 26, false));
+			else if (i % 50 == 25)
+				events.push_back(std::make_unique<Core::MouseButtonPressedEvent>(i % 3));
+			else
+				events.push_back(std::make_unique<Core::MouseMovedEvent>((double)(i % 1920), (double)(i % 1080)));
+		}
+
+		auto legacyLayers = CreateLayers<LegacyEventDispatcher>();
+		auto layers = CreateLayers<Core::EventDispatcher>();
+
+		double legacyMs = MeasureMedianMillis(3, 20, [&]()
+		{
+			for (const auto& event : events)
+				RaiseEvent<false>(legacyLayers, *event);
+		});
+
+		double dispatchMs = MeasureMedianMillis(3, 20, [&]()
+		{
+			for (const auto& event : events)
+				RaiseEvent<false>(layers, *event);
+		});
+
+		double filteredMs = MeasureMedianMillis(3, 20, [&]()
+		{
+			for (const auto& event : events)
+				RaiseEvent<true>(layers, *event);
+		});
+
+		std::println("{} events through {} layers, median of 20 runs", EventCount, layers.size());
+		std::println("{:<34} {:>14} {:>10}", "", "events/s", "speedup");
+		std::println("{:<34} {:>14.0f} {:>9.2f}x", "std::function dispatch, all layers", EventCount / (legacyMs / 1000.0), 1.0);
+		std::println("{:<34} {:>14.0f} {:>9.2f}x", "template dispatch, all layers", EventCount / (dispatchMs / 1000.0), legacyMs / dispatchMs);
+		std::println("{:<34} {:>14.0f} {:>9.2f}x", "template dispatch, by category", EventCount / (filteredMs / 1000.0), legacyMs / filteredMs);
+
+		return true;
+	}
+
+}
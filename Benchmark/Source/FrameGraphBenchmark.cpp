@@ -0,0 +1,130 @@
+#include "Benchmark.h"
+
+#include "Core/Renderer/FrameGraph.h"
+
+#include <print>
+
+namespace Benchmark {
+
+	using Renderer::FrameGraph;
+	using Renderer::FrameGraphAccess;
+	using Renderer::FrameGraphBuilder;
+	using Renderer::FrameGraphPassResources;
+	using Renderer::FrameGraphResource;
+
+	static void Nothing(const FrameGraphPassResources&) {}
+
+	// A writes X and Y, B only reads X, C has a side effect and reads Y: B goes, A stays for C
+	static bool CheckPartiallyReadProducer()
+	{
+		FrameGraph graph;
+		const FrameGraphResource x = graph.CreateTexture("X", { 64, 64, GL_RGBA8 });
+		const FrameGraphResource y = graph.CreateTexture("Y", { 64, 64, GL_RGBA8 });
+
+		graph.AddPass("A", [x, y](FrameGraphBuilder& builder) { builder.Write(x); builder.Write(y); }, Nothing);
+		graph.AddPass("B", [x](FrameGraphBuilder& builder) { builder.Read(x); }, Nothing);
+		graph.AddPass("C", [y](FrameGraphBuilder& builder) { builder.Read(y); builder.SetSideEffect(); }, Nothing);
+		graph.Compile();
+
+		return graph.GetStats().Passes == 2 && graph.GetStats().CulledPasses == 1;
+	}
+
+	// Nothing reads the end of the chain, so every pass of it goes
+	static bool CheckUnreadChain()
+	{
+		FrameGraph graph;
+		const FrameGraphResource x = graph.CreateTexture("X", { 64, 64, GL_RGBA8 });
+		const FrameGraphResource y = graph.CreateTexture("Y", { 64, 64, GL_RGBA8 });
+
+		graph.AddPass("A", [x](FrameGraphBuilder& builder) { builder.Write(x); }, Nothing);
+		graph.AddPass("B", [x, y](FrameGraphBuilder& builder) { builder.Read(x); builder.Write(y); }, Nothing);
+		graph.AddPass("C", [y](FrameGraphBuilder& builder) { builder.Read(y); }, Nothing);
+		graph.Compile();
+
+		return graph.GetStats().Passes == 0 && graph.GetStats().CulledPasses == 3;
+	}
+
+	// X dies in B before Z is first written in C, so Z takes X's texture; Y overlaps both
+	static bool CheckDisjointTransientsAlias()
+	{
+		FrameGraph graph;
+		const FrameGraphResource x = graph.CreateTexture("X", { 64, 64, GL_RGBA8 });
+		const FrameGraphResource y = graph.CreateTexture("Y", { 64, 64, GL_RGBA8 });
+		const FrameGraphResource z = graph.CreateTexture("Z", { 64, 64, GL_RGBA8 });
+
+		graph.AddPass("A", [x](FrameGraphBuilder& builder) { builder.Write(x); }, Nothing);
+		graph.AddPass("B", [x, y](FrameGraphBuilder& builder) { builder.Read(x); builder.Write(y); }, Nothing);
+		graph.AddPass("C", [y, z](FrameGraphBuilder& builder) { builder.Read(y); builder.Write(z); }, Nothing);
+		graph.AddPass("D", [z](FrameGraphBuilder& builder) { builder.Read(z); builder.SetSideEffect(); }, Nothing);
+		graph.Compile();
+
+		return graph.GetStats().TransientResources == 3 && graph.GetStats().TransientTextures == 2;
+	}
+
+	// Every layer draws into a transient of its own and composites it onto Scene Color, the
+	// composite of every fourth is missing so its draw is culled
+	static void BuildGraph(FrameGraph& graph, uint32_t layerCount)
+	{
+		graph.Reset();
+
+		const FrameGraphResource backbuffer = graph.ImportBackbuffer("Backbuffer", 1920, 1080);
+		const FrameGraphResource sceneColor = graph.CreateTexture("Scene Color", { 1920, 1080, GL_RGBA16F });
+
+		graph.AddPass("Clear", [sceneColor](FrameGraphBuilder& builder) { builder.Write(sceneColor); }, Nothing);
+
+		for (uint32_t i = 0; i < layerCount; i++)
+		{
+			const FrameGraphResource layer = graph.CreateTexture("Layer", { 960, 540, GL_RGBA16F });
+			graph.AddPass("Draw", [layer](FrameGraphBuilder& builder) { builder.Write(layer); }, Nothing);
+
+			if (i % 4 == 3)
+				continue;
+
+			graph.AddPass("Composite", [layer, sceneColor](FrameGraphBuilder& builder)
+			{
+				builder.Read(layer);
+				builder.Read(sceneColor, FrameGraphAccess::ColorAttachment);
+				builder.Write(sceneColor);
+			}, Nothing);
+		}
+
+		graph.AddPass("Present", [sceneColor, backbuffer](FrameGraphBuilder& builder)
+		{
+			builder.Read(sceneColor, FrameGraphAccess::Transfer);
+			builder.Write(backbuffer, FrameGraphAccess::Transfer);
+		}, Nothing);
+	}
+
+	bool RunFrameGraphBenchmark()
+	{
+		constexpr uint32_t Warmup = 3;
+		constexpr uint32_t Iterations = 20;
+
+		const bool partiallyRead = CheckPartiallyReadProducer();
+		const bool unreadChain = CheckUnreadChain();
+		const bool aliasing = CheckDisjointTransientsAlias();
+		std::println("Culling: partially read producer {}, unread chain {}", partiallyRead ? "ok" : "FAILED", unreadChain ? "ok" : "FAILED");
+		std::println("Aliasing: disjoint transients {}", aliasing ? "ok" : "FAILED");
+
+		std::println("Median of {} runs, build = Reset and AddPass for every pass, no GL work", Iterations);
+		std::println("{:<8} {:>8} {:>8} {:>10} {:>11} {:>12}", "layers", "passes", "culled", "textures", "build ms", "compile ms");
+
+		FrameGraph graph;
+		for (uint32_t layerCount : { 16u, 64u, 256u })
+		{
+			const double buildMs = MeasureMedianMillis(Warmup, Iterations, [&]() { BuildGraph(graph, layerCount); });
+			const double totalMs = MeasureMedianMillis(Warmup, Iterations, [&]()
+			{
+				BuildGraph(graph, layerCount);
+				graph.Compile();
+			});
+
+			const Renderer::FrameGraphStats& stats = graph.GetStats();
+			std::println("{:<8} {:>8} {:>8} {:>10} {:>11.3f} {:>12.3f}", layerCount, stats.Passes, stats.CulledPasses,
+				stats.TransientTextures, buildMs, totalMs - buildMs);
+		}
+
+		return partiallyRead && unreadChain && aliasing;
+	}
+
+}
@@ -0,0 +1,178 @@
+#include "Benchmark.h"
+
+#include "Core/FrameAllocator.h"
+#include "Core/Window.h"
+#include "Core/Renderer/FramebufferPool.h"
+#include "Core/Renderer/RenderCommandQueue.h"
+#include "Core/Renderer/RenderState.h"
+#include "Core/Renderer/Renderer2D.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <print>
+#include <vector>
+
+namespace Benchmark {
+
+	using Renderer::FramebufferFormat;
+
+	// Blended fullscreen quads per frame, each reads and writes every pixel of the target
+	static constexpr uint32_t LayersPerFrame = 8;
+
+	struct TargetCase
+	{
+		const char* Label;
+		FramebufferFormat Color;
+		FramebufferFormat Depth = FramebufferFormat::None;
+		uint32_t Samples = 1;
+	};
+
+	static const TargetCase s_Cases[] = {
+		{ "RGBA32F",             FramebufferFormat::RGBA32F },
+		{ "RGBA16F",             FramebufferFormat::RGBA16F },
+		{ "R11G11B10F",          FramebufferFormat::R11G11B10F },
+		{ "RGBA8",               FramebufferFormat::RGBA8 },
+		{ "RGBA16F + D24S8",     FramebufferFormat::RGBA16F, FramebufferFormat::Depth24Stencil8 },
+		{ "RGBA8 + D32F",        FramebufferFormat::RGBA8, FramebufferFormat::Depth32F },
+		{ "RGBA16F MSAA 4x",     FramebufferFormat::RGBA16F, FramebufferFormat::Depth24Stencil8, 4 },
+		{ "R11G11B10F MSAA 4x",  FramebufferFormat::R11G11B10F, FramebufferFormat::Depth24Stencil8, 4 },
+		{ "RGBA8 MSAA 4x",       FramebufferFormat::RGBA8, FramebufferFormat::Depth24Stencil8, 4 },
+	};
+
+	// Clears target, blends the layers over it and resolves, returns the GPU time in ms
+	static double DrawFrame(Renderer::FrameGraph& graph, Renderer::RenderTarget* target, GLuint query)
+	{
+		Renderer::Submit([target, query]()
+		{
+			glBeginQuery(GL_TIME_ELAPSED, query);
+
+			Renderer::RenderState::BindFramebuffer(GL_FRAMEBUFFER, target->GetFramebuffer());
+			Renderer::RenderState::SetViewport(0, 0, target->GetSpec().Width, target->GetSpec().Height);
+			Renderer::RenderState::SetClearColor(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+			Renderer::RenderState::SetDepthWrite(true);
+			glClear(GL_COLOR_BUFFER_BIT | (target->GetSpec().DepthFormat != FramebufferFormat::None ? GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT : 0));
+		});
+
+		graph.Reset();
+		const Renderer::FrameGraphResource backbuffer = graph.ImportBackbuffer("Backbuffer", target->GetSpec().Width, target->GetSpec().Height);
+
+		// The unit quad scaled to clip space covers the target
+		Renderer::BeginScene2D(glm::mat4(1.0f));
+		for (uint32_t i = 0; i < LayersPerFrame; i++)
+			Renderer::DrawQuad(glm::vec2(0.0f), glm::vec2(2.0f), 0, glm::vec4(0.1f * i, 0.5f, 1.0f - 0.1f * i, 0.25f));
+		Renderer::EndScene2D(graph, backbuffer);
+
+		graph.Compile();
+		Renderer::Submit([&graph]() { graph.Execute(); });
+
+		Renderer::Submit([target, query]()
+		{
+			target->Resolve();
+			glEndQuery(GL_TIME_ELAPSED);
+		});
+
+		Renderer::SwapQueues();
+		Renderer::ExecuteRenderQueue();
+		Core::FrameAllocator::NextFrame();
+
+		GLuint64 elapsed = 0;
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+		return elapsed / 1'000'000.0;
+	}
+
+	static void MeasureTarget(const TargetCase& testCase, uint32_t width, uint32_t height, GLuint query)
+	{
+		constexpr uint32_t Warmup = 3;
+		constexpr uint32_t Iterations = 20;
+
+		Renderer::FramebufferSpec spec;
+		spec.Width = width;
+		spec.Height = height;
+		spec.ColorFormats[0] = testCase.Color;
+		spec.DepthFormat = testCase.Depth;
+		spec.Samples = testCase.Samples;
+
+		Renderer::RenderTarget* target = Renderer::FramebufferPool::Acquire(spec);
+		// The graph's Renderer2D pass draws into the backbuffer
+		const GLuint backbuffer = Renderer::GetBackbuffer();
+		Renderer::SetBackbuffer(target->GetFramebuffer());
+
+		Renderer::FrameGraph graph;
+
+		std::vector<double> samples(Iterations);
+		for (uint32_t i = 0; i < Warmup + Iterations; i++)
+		{
+			const double gpuMs = DrawFrame(graph, target, query);
+			if (i >= Warmup)
+				samples[i - Warmup] = gpuMs;
+		}
+
+		std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+		const double gpuMs = samples[samples.size() / 2];
+
+		// Every layer reads and writes each sample of the color attachment
+		const uint64_t colorBytes = (uint64_t)width * height * target->GetSpec().Samples * Renderer::GetBytesPerPixel(Renderer::GetInternalFormat(testCase.Color));
+		const double blendGBps = colorBytes * 2.0 * LayersPerFrame / (gpuMs / 1000.0) / 1e9;
+
+		std::println("{:<20} {:>5}x{:<5} {:>10.1f} {:>10.3f} {:>12.1f}", testCase.Label, width, height,
+			target->GetMemoryBytes() / (1024.0 * 1024.0), gpuMs, blendGBps);
+
+		Renderer::SetBackbuffer(backbuffer);
+		Renderer::FramebufferPool::Release(target);
+	}
+
+	bool RunFramebufferBenchmark()
+	{
+		// Offscreen like the App's --headless, no display needed
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+		if (!glfwInit())
+		{
+			std::println("Skipped, GLFW failed to initialize");
+			return true;
+		}
+
+		// For the Renderer2D scenes
+		Core::FrameAllocator::Init(1024 * 1024);
+
+		{
+			Core::WindowSpecification windowSpec;
+			windowSpec.Title = "Framebuffer Benchmark";
+			windowSpec.Width = 256;
+			windowSpec.Height = 256;
+			windowSpec.Headless = true;
+
+			Core::Window window(windowSpec);
+			window.Create();
+
+			GLuint query = 0;
+			glGenQueries(1, &query);
+
+			std::println("Median GPU time of 20 frames, each a clear, {} blended fullscreen quads and the MSAA resolve", LayersPerFrame);
+			std::println("{:<20} {:>11} {:>10} {:>10} {:>12}", "", "size", "memory MB", "GPU ms", "blend GB/s");
+
+			const glm::uvec2 sizes[] = { { 1920, 1080 }, { 2560, 1440 } };
+			// The second size reallocates the idle targets of the first instead of adding to them
+			for (const glm::uvec2& size : sizes)
+			{
+				for (const TargetCase& testCase : s_Cases)
+					MeasureTarget(testCase, size.x, size.y, query);
+			}
+
+			Renderer::FramebufferPoolStats stats = Renderer::FramebufferPool::GetStats();
+			std::println("Pool: {} created, {} resized, {} reused", stats.Created, stats.Resized, stats.Reused);
+
+			glDeleteQueries(1, &query);
+			Renderer::ShutdownFrameGraph();
+			Renderer::FramebufferPool::Shutdown();
+			Renderer::ShutdownRenderer2D();
+
+			window.Destroy();
+		}
+
+		glfwTerminate();
+
+		return true;
+	}
+
+}
@@ -0,0 +1,114 @@
+#include "Benchmark.h"
+
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Jobs/LayerScheduler.h"
+
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <print>
+#include <thread>
+#include <vector>
+
+namespace Benchmark {
+
+	// Stand-in for a gameplay layer: integrates a particle system in OnUpdate
+	class ParticleLayer : public Core::Layer
+	{
+	public:
+		ParticleLayer(uint32_t particleCount)
+			: Layer("ParticleLayer"), m_Positions(particleCount, glm::vec3(0.0f)), m_Velocities(particleCount)
+		{
+			SetParallelUpdate(true);
+
+			for (uint32_t i = 0; i < particleCount; i++)
+				m_Velocities[i] = glm::vec3((float)(i % 7), (float)(i % 13), (float)(i % 5)) * 0.1f;
+		}
+
+		virtual void OnUpdate(float ts) override
+		{
+			const glm::vec3 gravity(0.0f, -9.81f, 0.0f);
+			for (size_t i = 0; i < m_Positions.size(); i++)
+			{
+				m_Velocities[i] += gravity * ts;
+				m_Velocities[i] *= 0.99f;
+				m_Positions[i] += m_Velocities[i] * ts;
+
+				if (m_Positions[i].y < 0.0f)
+				{
+					m_Positions[i].y = -m_Positions[i].y;
+					m_Velocities[i].y = glm::abs(m_Velocities[i].y);
+				}
+			}
+
+			DoNotOptimize(m_Positions[0]);
+		}
+	private:
+		std::vector<glm::vec3> m_Positions;
+		std::vector<glm::vec3> m_Velocities;
+	};
+
+	// Depends on every ParticleLayer, so it always lands in a later wave
+	class GatherLayer : public Core::Layer
+	{
+	public:
+		GatherLayer()
+			: Layer("GatherLayer")
+		{
+			AddUpdateDependency<ParticleLayer>();
+		}
+
+		virtual void OnUpdate(float ts) override
+		{
+			m_Accumulated += ts;
+			DoNotOptimize(m_Accumulated);
+		}
+	private:
+		float m_Accumulated = 0.0f;
+	};
+
+	bool RunJobSystemBenchmark()
+	{
+		constexpr uint32_t LayerCount = 16;
+		constexpr uint32_t ParticlesPerLayer = 100'000;
+		constexpr uint32_t WarmupFrames = 10;
+		constexpr uint32_t MeasuredFrames = 100;
+
+		std::vector<std::unique_ptr<Core::Layer>> layers;
+		for (uint32_t i = 0; i < LayerCount; i++)
+			layers.push_back(std::make_unique<ParticleLayer>(ParticlesPerLayer));
+		layers.push_back(std::make_unique<GatherLayer>());
+
+		const uint32_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		std::vector<uint32_t> threadCounts = { 1, 2, 4 };
+		if (hardwareThreads > 4)
+			threadCounts.push_back(hardwareThreads);
+
+		std::println("{} layers x {} particles, median of {} frames", LayerCount, ParticlesPerLayer, MeasuredFrames);
+		std::println("{:>8} {:>12} {:>10}", "threads", "update (ms)", "speedup");
+
+		double baseline = 0.0;
+		for (uint32_t threadCount : threadCounts)
+		{
+			// Workers exclude the calling thread. Without a job system everything runs inline,
+			// which is the single-threaded baseline.
+			if (threadCount > 1)
+				Core::JobSystem::Init(threadCount - 1);
+
+			double ms = MeasureMedianMillis(WarmupFrames, MeasuredFrames, [&]()
+			{
+				Core::ScheduleLayerUpdates(layers, [](Core::Layer& layer) { layer.OnUpdate(1.0f / 60.0f); });
+			});
+
+			if (threadCount > 1)
+				Core::JobSystem::Shutdown();
+			else
+				baseline = ms;
+
+			std::println("{:>8} {:>12.3f} {:>9.2f}x", threadCount, ms, baseline / ms);
+		}
+
+		return true;
+	}
+
+}
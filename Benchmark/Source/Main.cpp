@@ -0,0 +1,62 @@
+#include "Benchmark.h"
+
+#include <print>
+#include <string_view>
+
+struct BenchmarkEntry
+{
+	const char* Name;
+	const char* Description;
+	bool (*Run)(); // False when a self-check failed
+};
+
+static const BenchmarkEntry s_Benchmarks[] = {
+	{ "jobs", "Layer update scaling across job system thread counts", Benchmark::RunJobSystemBenchmark },
+	{ "events", "Event dispatch throughput with and without category filtering", Benchmark::RunEventDispatchBenchmark },
+	{ "renderer2d", "Instanced quad batching, 1M quads per frame", Benchmark::RunRenderer2DBenchmark },
+	{ "framebuffers", "Render target memory and blended fill time per format and MSAA", Benchmark::RunFramebufferBenchmark },
+	{ "framegraph", "Frame graph build and compile time, culling and aliasing self-checks", Benchmark::RunFrameGraphBenchmark },
+	{ "transforms", "SoA transform composition and half packing, scalar vs AVX2", Benchmark::RunTransformBenchmark },
+};
+
+static void PrintUsage()
+{
+	std::println("Usage: Benchmark [name...]");
+	std::println("Runs every benchmark when no name is given. Available benchmarks:");
+	for (const BenchmarkEntry& entry : s_Benchmarks)
+		std::println("  {:<12} {}", entry.Name, entry.Description);
+}
+
+int main(int argc, char** argv)
+{
+	// Every benchmark still runs after a failed check, the exit code gates CI
+	bool passed = true;
+
+	if (argc < 2)
+	{
+		for (const BenchmarkEntry& entry : s_Benchmarks)
+		{
+			std::println("=== {} ===", entry.Name);
+			passed &= entry.Run();
+		}
+		return passed ? 0 : 1;
+	}
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string_view name = argv[i];
+
+		auto it = std::find_if(std::begin(s_Benchmarks), std::end(s_Benchmarks), [name](const BenchmarkEntry& entry) { return name == entry.Name; });
+		if (it == std::end(s_Benchmarks))
+		{
+			std::println("Unknown benchmark '{}'", name);
+			PrintUsage();
+			return 1;
+		}
+
+		std::println("=== {} ===", it->Name);
+		passed &= it->Run();
+	}
+
+	return passed ? 0 : 1;
+}
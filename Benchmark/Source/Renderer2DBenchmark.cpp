@@ -0,0 +1,147 @@
+#include "Benchmark.h"
+
+#include "Core/FrameAllocator.h"
+#include "Core/Window.h"
+#include "Core/Renderer/RenderCommandQueue.h"
+#include "Core/Renderer/Renderer2D.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <print>
+#include <vector>
+
+namespace Benchmark {
+
+	static constexpr uint32_t TextureCount = 40; // More than fit in one batch
+
+	static std::vector<GLuint> CreateTextures()
+	{
+		std::vector<GLuint> textures(TextureCount);
+		glCreateTextures(GL_TEXTURE_2D, TextureCount, textures.data());
+
+		for (uint32_t i = 0; i < TextureCount; i++)
+		{
+			uint32_t pixels[16];
+			std::fill(std::begin(pixels), std::end(pixels), 0xff000000 | (i * 0x060403));
+			glTextureStorage2D(textures[i], 1, GL_RGBA8, 4, 4);
+			glTextureSubImage2D(textures[i], 0, 0, 0, 4, 4, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+		}
+		return textures;
+	}
+
+	// Records quadCount quads split into scenes of quadsPerScene, then executes them and waits for the GPU
+	static void DrawQuads(Renderer::FrameGraph& graph, uint32_t quadCount, uint32_t quadsPerScene, const std::vector<GLuint>& textures, double& recordMs, double& totalMs)
+	{
+		// Pixel coordinates on a 1920x1080 target
+		glm::mat4 viewProjection(1.0f);
+		viewProjection[0][0] = 2.0f / 1920.0f;
+		viewProjection[1][1] = 2.0f / 1080.0f;
+		viewProjection[3][0] = -1.0f;
+		viewProjection[3][1] = -1.0f;
+
+		graph.Reset();
+		const Renderer::FrameGraphResource backbuffer = graph.ImportBackbuffer("Backbuffer", 1920, 1080);
+
+		Timer timer;
+
+		for (uint32_t first = 0; first < quadCount; first += quadsPerScene)
+		{
+			Renderer::BeginScene2D(viewProjection);
+
+			const uint32_t last = std::min(first + quadsPerScene, quadCount);
+			for (uint32_t i = first; i < last; i++)
+			{
+				glm::vec2 position((float)(i % 1920), (float)((i / 1920) % 1080));
+				Renderer::DrawQuad(position, glm::vec2(4.0f), textures[(i / 64) % TextureCount], glm::vec4(1.0f, 1.0f, 1.0f, 0.5f));
+			}
+
+			Renderer::EndScene2D(graph, backbuffer);
+		}
+
+		recordMs = timer.ElapsedMillis();
+
+		graph.Compile();
+		Renderer::Submit([&graph]() { graph.Execute(); });
+
+		Renderer::SwapQueues();
+		Renderer::ExecuteRenderQueue();
+		glFinish();
+
+		totalMs = timer.ElapsedMillis();
+	}
+
+	static void MeasureQuads(const char* label, uint32_t quadCount, uint32_t quadsPerScene, const std::vector<GLuint>& textures)
+	{
+		constexpr uint32_t Warmup = 3;
+		constexpr uint32_t Iterations = 10;
+
+		Renderer::FrameGraph graph;
+
+		std::vector<double> record(Iterations), total(Iterations);
+		for (uint32_t i = 0; i < Warmup + Iterations; i++)
+		{
+			double recordMs = 0.0, totalMs = 0.0;
+			Renderer::ResetRenderer2DStats();
+			DrawQuads(graph, quadCount, quadsPerScene, textures, recordMs, totalMs);
+			Core::FrameAllocator::NextFrame();
+
+			if (i >= Warmup)
+			{
+				record[i - Warmup] = recordMs;
+				total[i - Warmup] = totalMs;
+			}
+		}
+
+		std::sort(record.begin(), record.end());
+		std::sort(total.begin(), total.end());
+		const double recordMs = record[Iterations / 2];
+		const double totalMs = total[Iterations / 2];
+
+		Renderer::Renderer2DStats stats = Renderer::GetRenderer2DStats();
+		std::println("{:<20} {:>9} {:>10} {:>11.2f} {:>11.2f} {:>12.1f}", label, stats.Quads, stats.DrawCalls, recordMs, totalMs, quadCount / totalMs / 1000.0);
+	}
+
+	bool RunRenderer2DBenchmark()
+	{
+		// Offscreen like the App's --headless, no display needed
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+		if (!glfwInit())
+		{
+			std::println("Skipped, GLFW failed to initialize");
+			return true;
+		}
+
+		// Scenes are recorded into the frame arena, 1M quads take 48 MB
+		Core::FrameAllocator::Init(64 * 1024 * 1024);
+
+		{
+			Core::WindowSpecification windowSpec;
+			windowSpec.Title = "Renderer2D Benchmark";
+			windowSpec.Width = 1920;
+			windowSpec.Height = 1080;
+			windowSpec.Headless = true;
+
+			Core::Window window(windowSpec);
+			window.Create();
+
+			std::vector<GLuint> textures = CreateTextures();
+
+			std::println("Median of 10 frames, record = BeginScene2D..EndScene2D on the CPU, total adds execution and glFinish");
+			std::println("{:<20} {:>9} {:>10} {:>11} {:>11} {:>12}", "", "quads", "draws", "record ms", "total ms", "Mquads/s");
+			MeasureQuads("batched", 1'000'000, 1'000'000, textures);
+			// What drawing every quad on its own costs
+			MeasureQuads("one draw per quad", 10'000, 1, textures);
+
+			Renderer::ShutdownRenderer2D();
+			glDeleteTextures(TextureCount, textures.data());
+
+			window.Destroy();
+		}
+
+		glfwTerminate();
+
+		return true;
+	}
+
+}
@@ -0,0 +1,149 @@
+#include "Benchmark.h"
+
+#include "Core/TransformBatch.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <print>
+#include <random>
+#include <vector>
+
+namespace Benchmark {
+
+	struct Transform
+	{
+		glm::vec3 Translation;
+		glm::quat Rotation;
+		glm::vec3 Scale;
+		uint32_t Parent;
+	};
+
+	static std::vector<Transform> CreateTransforms(uint32_t count, uint32_t parentCount, std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+		std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+		std::uniform_int_distribution<uint32_t> parent(0, parentCount > 0 ? parentCount - 1 : 0);
+
+		std::vector<Transform> transforms(count);
+		for (Transform& transform : transforms)
+		{
+			const glm::vec3 axis(unit(rng), unit(rng), unit(rng) + 2.0f);
+			transform.Translation = { position(rng), position(rng), position(rng) };
+			transform.Rotation = glm::angleAxis(angle(rng), glm::normalize(axis));
+			transform.Scale = { scale(rng), scale(rng), scale(rng) };
+			transform.Parent = parent(rng);
+		}
+		return transforms;
+	}
+
+	static void RunTransformCount(uint32_t count, std::mt19937& rng)
+	{
+		constexpr uint32_t Warmup = 3;
+		constexpr uint32_t Iterations = 15;
+
+		const uint32_t parentCount = std::max(count / 16, 1u);
+		const std::vector<Transform> parentTransforms = CreateTransforms(parentCount, 0, rng);
+		const std::vector<Transform> transforms = CreateTransforms(count, parentCount, rng);
+
+		// Per-transform glm matrices, the way the layers build them today
+		std::vector<glm::mat4> parentWorld(parentCount);
+		std::vector<glm::mat4> world(count);
+		for (uint32_t i = 0; i < parentCount; i++)
+		{
+			const Transform& t = parentTransforms[i];
+			parentWorld[i] = glm::translate(glm::mat4(1.0f), t.Translation) * glm::mat4_cast(t.Rotation) * glm::scale(glm::mat4(1.0f), t.Scale);
+		}
+
+		double glmMs = MeasureMedianMillis(Warmup, Iterations, [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const Transform& t = transforms[i];
+				const glm::mat4 local = glm::translate(glm::mat4(1.0f), t.Translation) * glm::mat4_cast(t.Rotation) * glm::scale(glm::mat4(1.0f), t.Scale);
+				world[i] = parentWorld[t.Parent] * local;
+			}
+			DoNotOptimize(world.back());
+		});
+
+		Core::TransformBatch parents;
+		for (const Transform& t : parentTransforms)
+			parents.Add(t.Translation, t.Rotation, t.Scale);
+		parents.Update();
+
+		Core::TransformBatch batch;
+		for (const Transform& t : transforms)
+			batch.Add(t.Translation, t.Rotation, t.Scale, t.Parent);
+
+		std::vector<Core::PackedTransform> packed(count);
+		std::vector<Core::PackedTransform> scalarPacked(count);
+
+		double updateMs[2], packMs[2];
+		const Core::TransformKernel kernels[2] = { Core::TransformKernel::Scalar, Core::TransformKernel::AVX2 };
+		for (int k = 0; k < 2; k++)
+		{
+			updateMs[k] = MeasureMedianMillis(Warmup, Iterations, [&]()
+			{
+				batch.Update(&parents, kernels[k]);
+			});
+
+			packMs[k] = MeasureMedianMillis(Warmup, Iterations, [&]()
+			{
+				batch.Pack(packed.data(), kernels[k]);
+				DoNotOptimize(packed.back());
+			});
+
+			if (k == 0)
+			{
+				scalarPacked = packed;
+				for (uint32_t i = 0; i < count; i++)
+					world[i] = batch.GetWorldMatrix(i);
+			}
+		}
+
+		// The AVX2 results are still in batch and packed
+		float maxError = 0.0f;
+		uint32_t packedMismatches = 0;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const glm::mat4 matrix = batch.GetWorldMatrix(i);
+			for (int column = 0; column < 4; column++)
+			{
+				for (int row = 0; row < 3; row++)
+					maxError = std::max(maxError, std::abs(matrix[column][row] - world[i][column][row]));
+			}
+
+			if (memcmp(&packed[i], &scalarPacked[i], sizeof(Core::PackedTransform)) != 0)
+				packedMismatches++;
+		}
+
+		auto rate = [count](double ms) { return count / (ms * 1000.0); };
+
+		std::println("{} transforms under {} parents, median of {} runs{}", count, parentCount, Iterations,
+			TRANSFORM_BATCH_AVX2 ? "" : " (built without AVX2, both kernels are scalar)");
+		std::println("{:<28} {:>10} {:>14} {:>10}", "", "ms", "Mtransforms/s", "speedup");
+		std::println("{:<28} {:>10.3f} {:>14.1f} {:>9.2f}x", "update, glm mat4 each", glmMs, rate(glmMs), 1.0);
+		std::println("{:<28} {:>10.3f} {:>14.1f} {:>9.2f}x", "update, SoA scalar", updateMs[0], rate(updateMs[0]), glmMs / updateMs[0]);
+		std::println("{:<28} {:>10.3f} {:>14.1f} {:>9.2f}x", "update, SoA AVX2", updateMs[1], rate(updateMs[1]), glmMs / updateMs[1]);
+		std::println("{:<28} {:>10.3f} {:>14.1f} {:>9.2f}x", "pack halves, scalar", packMs[0], rate(packMs[0]), 1.0);
+		std::println("{:<28} {:>10.3f} {:>14.1f} {:>9.2f}x", "pack halves, F16C", packMs[1], rate(packMs[1]), packMs[0] / packMs[1]);
+		std::println("AVX2 vs scalar: max matrix difference {:.3g}, {} packed transforms differ", maxError, packedMismatches);
+		std::println("");
+	}
+
+	bool RunTransformBenchmark()
+	{
+		std::mt19937 rng(1234);
+		for (uint32_t count : { 10'000u, 100'000u, 1'000'000u })
+			RunTransformCount(count, rng);
+
+		return true;
+	}
+
+}
@@ -0,0 +1,98 @@
+#include "Core/FileWatcher.h"
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+
+namespace Core {
+
+	class LinuxFileWatcher : public FileWatcher
+	{
+	public:
+		LinuxFileWatcher(const std::filesystem::path& directory)
+		{
+			m_FD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+			if (m_FD < 0)
+			{
+				std::cerr << "Failed to initialize inotify for " << directory.string() << std::endl;
+				return;
+			}
+
+			std::error_code error;
+			std::filesystem::path root = std::filesystem::absolute(directory, error);
+			AddWatch(root);
+
+			for (const auto& entry : std::filesystem::recursive_directory_iterator(root, error))
+			{
+				if (entry.is_directory())
+					AddWatch(entry.path());
+			}
+		}
+
+		virtual ~LinuxFileWatcher()
+		{
+			if (m_FD >= 0)
+				close(m_FD);
+		}
+
+		virtual std::vector<std::filesystem::path> PollChanges() override
+		{
+			std::vector<std::filesystem::path> changes;
+			if (m_FD < 0)
+				return changes;
+
+			alignas(inotify_event) char buffer[4096];
+			while (true)
+			{
+				ssize_t length = read(m_FD, buffer, sizeof(buffer));
+				if (length <= 0)
+					break; // EAGAIN, nothing left to read
+
+				for (char* ptr = buffer; ptr < buffer + length; )
+				{
+					const inotify_event* event = (const inotify_event*)ptr;
+					ptr += sizeof(inotify_event) + event->len;
+
+					auto it = m_WatchDirectories.find(event->wd);
+					if (it == m_WatchDirectories.end() || event->len == 0)
+						continue;
+
+					std::filesystem::path path = it->second / event->name;
+
+					// Start watching directories that show up later on
+					if (event->mask & IN_ISDIR)
+					{
+						if (event->mask & (IN_CREATE | IN_MOVED_TO))
+							AddWatch(path);
+						continue;
+					}
+
+					if (std::find(changes.begin(), changes.end(), path) == changes.end())
+						changes.push_back(std::move(path));
+				}
+			}
+
+			return changes;
+		}
+	private:
+		void AddWatch(const std::filesystem::path& directory)
+		{
+			// Editors that save via a temporary file and rename show up as IN_MOVED_TO
+			int wd = inotify_add_watch(m_FD, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+			if (wd >= 0)
+				m_WatchDirectories[wd] = directory;
+		}
+	private:
+		int m_FD = -1;
+		std::unordered_map<int, std::filesystem::path> m_WatchDirectories;
+	};
+
+	std::unique_ptr<FileWatcher> FileWatcher::Create(const std::filesystem::path& directory)
+	{
+		return std::make_unique<LinuxFileWatcher>(directory);
+	}
+
+}
@@ -0,0 +1,93 @@
+#include "Core/FileWatcher.h"
+
+#include <Windows.h>
+
+#include <algorithm>
+#include <iostream>
+
+namespace Core {
+
+	class WindowsFileWatcher : public FileWatcher
+	{
+	public:
+		WindowsFileWatcher(const std::filesystem::path& directory)
+		{
+			std::error_code error;
+			m_Directory = std::filesystem::absolute(directory, error);
+
+			m_DirectoryHandle = CreateFileW(m_Directory.c_str(), FILE_LIST_DIRECTORY,
+				FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+				OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+
+			if (m_DirectoryHandle == INVALID_HANDLE_VALUE)
+			{
+				std::cerr << "Failed to watch directory " << m_Directory.string() << std::endl;
+				return;
+			}
+
+			m_Overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+			IssueRead();
+		}
+
+		virtual ~WindowsFileWatcher()
+		{
+			if (m_DirectoryHandle != INVALID_HANDLE_VALUE)
+			{
+				CancelIo(m_DirectoryHandle);
+				CloseHandle(m_DirectoryHandle);
+			}
+
+			if (m_Overlapped.hEvent)
+				CloseHandle(m_Overlapped.hEvent);
+		}
+
+		virtual std::vector<std::filesystem::path> PollChanges() override
+		{
+			std::vector<std::filesystem::path> changes;
+			if (m_DirectoryHandle == INVALID_HANDLE_VALUE)
+				return changes;
+
+			DWORD bytes = 0;
+			while (GetOverlappedResult(m_DirectoryHandle, &m_Overlapped, &bytes, FALSE))
+			{
+				for (DWORD offset = 0; bytes > 0; )
+				{
+					const FILE_NOTIFY_INFORMATION* info = (const FILE_NOTIFY_INFORMATION*)(m_Buffer + offset);
+
+					if (info->Action == FILE_ACTION_MODIFIED || info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+					{
+						std::filesystem::path path = m_Directory / std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR));
+						if (!std::filesystem::is_directory(path) && std::find(changes.begin(), changes.end(), path) == changes.end())
+							changes.push_back(std::move(path));
+					}
+
+					if (info->NextEntryOffset == 0)
+						break;
+					offset += info->NextEntryOffset;
+				}
+
+				IssueRead();
+			}
+
+			return changes;
+		}
+	private:
+		void IssueRead()
+		{
+			ResetEvent(m_Overlapped.hEvent);
+			ReadDirectoryChangesW(m_DirectoryHandle, m_Buffer, sizeof(m_Buffer), TRUE,
+				FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, nullptr, &m_Overlapped, nullptr);
+		}
+	private:
+		std::filesystem::path m_Directory;
+		HANDLE m_DirectoryHandle = INVALID_HANDLE_VALUE;
+		OVERLAPPED m_Overlapped{};
+		alignas(DWORD) BYTE m_Buffer[16 * 1024];
+	};
+
+	std::unique_ptr<FileWatcher> FileWatcher::Create(const std::filesystem::path& directory)
+	{
+		return std::make_unique<WindowsFileWatcher>(directory);
+	}
+
+}
@@ -1,14 +1,35 @@
 #include "Application.h"
 
+#include "Debug/GPUProfiler.h"
+#include "Debug/MemoryTracker.h"
 #include "Debug/Profiler.h"
+#include "FrameAllocator.h"
+#include "Jobs/JobSystem.h"
+#include "Jobs/LayerScheduler.h"
+#include "Renderer/FramebufferPool.h"
 #include "Renderer/GLUtils.h"
+#include "Renderer/PostProcessing.h"
+#include "Renderer/RenderCommandQueue.h"
+#include "Renderer/RenderState.h"
+#include "Renderer/Renderer2D.h"
+#include "Renderer/ShaderCache.h"
+#include "Renderer/ShaderHotReload.h"
+#include "Renderer/StreamingBuffer.h"
+#include "Renderer/TextureStreaming.h"
+#include "Renderer/UniformBuffers.h"
 
 #include <GLFW/glfw3.h>
 
 #include <glm/glm.hpp>
 
 #include <assert.h>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <format>
 #include <iostream>
+#include <iterator>
+#include <print>
 #include <ranges>
 
 
@@ -23,20 +44,49 @@ namespace Core {
 	}
 
 	Application::Application(const ApplicationSpecification& specification)
-		: m_Specification(specification)
+		: m_Specification(specification), m_PostProcessSettings(specification.PostProcess)
 	{
 		PROFILE_FUNC();
 
 		s_Application = this;
 
+		SetAllocationThreadName("Main Thread");
+		StartMemoryTracking();
+
+		JobSystem::Init(m_Specification.WorkerThreadCount);
+		FrameAllocator::Init(m_Specification.FrameArenaSize);
+
+		Renderer::SetShaderCacheDirectory(m_Specification.ShaderCacheDirectory);
+
 		glfwSetErrorCallback(GLFWErrorCallback);
+
+		// The null platform needs no display server, contexts come from EGL or OSMesa
+		if (m_Specification.Headless)
+			glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+
 		glfwInit();
 
 		// Set window title to app name if empty
 		if (m_Specification.WindowSpec.Title.empty())
 			m_Specification.WindowSpec.Title = m_Specification.Name;
 
-		m_Specification.WindowSpec.EventCallback = [this](Event& event) { RaiseEvent(event); };
+		if (!m_Specification.InputReplayPath.empty())
+			m_InputRecorder.LoadReplay(m_Specification.InputReplayPath);
+		else if (!m_Specification.InputRecordPath.empty())
+			m_InputRecorder.BeginRecording(m_Specification.InputRecordPath);
+
+		// Window events are queued and dispatched once per frame, see Run
+		m_Specification.WindowSpec.EventCallback = [this](Event& event)
+		{
+			// Live input would make the replay diverge
+			if (m_InputRecorder.IsReplaying())
+				return;
+
+			m_InputRecorder.Record(m_FrameIndex, event);
+			m_EventQueue.Push(event);
+		};
+
+		m_Specification.WindowSpec.Headless = m_Specification.Headless;
 
 		m_Window = std::make_shared<Window>(m_Specification.WindowSpec);
 		m_Window->Create();
@@ -45,14 +95,38 @@ namespace Core {
 		PushLayer<ImGuiLayer>();
 
 		Renderer::Utils::InitOpenGLDebugMessageCallback();
+
+		Renderer::InitShaderHotReload(m_Window->GetHandle(), m_Specification.ShaderHotReloadDirectory);
+
+		Renderer::Submit([size = m_Specification.StreamingBufferSize]() { Renderer::GetStreamingBuffer().Create(size); });
 	}
 
 	Application::~Application()
 	{
+		m_RenderThread.Terminate();
+
+		// Layer destructors record their GL cleanup, run it while the context is still alive
+		m_LayerStack.clear();
+		Renderer::Submit([]() { Renderer::ShutdownTextureStreaming(); });
+		Renderer::Submit([]() { Renderer::ShutdownRenderer2D(); });
+		Renderer::Submit([]() { Renderer::ShutdownPostProcessing(); });
+		Renderer::Submit([]() { Renderer::ShutdownFrameGraph(); });
+		Renderer::Submit([]() { Renderer::FramebufferPool::Shutdown(); });
+		Renderer::Submit([]() { Renderer::ShutdownUniformBuffers(); });
+		Renderer::Submit([]() { Renderer::GetStreamingBuffer().Destroy(); });
+		Renderer::Submit([]() { ShutdownGPUProfiler(); });
+		m_RenderThread.NextFrame();
+
+		Renderer::ShutdownShaderHotReload();
+
 		m_Window->Destroy();
 
 		glfwTerminate();
 
+		JobSystem::Shutdown();
+
+		FrameAllocator::Shutdown();
+
 		s_Application = nullptr;
 	}
 
@@ -60,33 +134,126 @@ namespace Core {
 	{
 		m_Running = true;
 
-		float lastTime = GetTime();
+		if (m_Specification.UseRenderThread)
+			m_RenderThread.Run(m_Window->GetHandle());
+
+		m_FramePacer.SetTargetFrameRate(m_Specification.TargetFrameRate);
+		m_FrameProfiler.SetHistoryLimit(m_Specification.FrameTimingHistory);
+		m_DynamicResolution.SetSettings(m_Specification.DynamicResolution);
+
+		uint64_t lastTime = GetTime();
+		const uint64_t startTime = lastTime;
 
 		// Main Application loop
 		while (m_Running)
 		{
 			PROFILE_SCOPE();
 
+			if (m_Specification.LowLatencyMode)
+				m_RenderThread.WaitIdle();
+
+			m_FramePacer.Wait();
+
+			m_FrameProfiler.BeginFrame(m_FrameIndex);
+
 			glfwPollEvents();
 
+			m_InputRecorder.ReplayFrame(m_FrameIndex, m_EventQueue);
+
+			{
+				PROFILE_SCOPE("Dispatch Events");
+				m_EventQueue.Dispatch([this](Event& event) { RaiseEvent(event); });
+			}
+
 			if (m_Window->ShouldClose())
 			{
 				Stop();
 				break;
 			}
 
-			float currentTime = GetTime();
-			float timestep = glm::clamp(currentTime - lastTime, 0.001f, 0.1f);
+			if (m_InputRecorder.IsReplayFinished(m_FrameIndex))
+			{
+				Stop();
+				break;
+			}
+
+			// Before anything updates, so a layer pushed by a transition gets its OnUpdate before its first OnRender
+			ApplyLayerTransitions();
+
+			// Only once the frame is sure to run, so every begin gets its end below
+			Renderer::Submit([frameIndex = m_FrameIndex]()
+			{
+				BeginGPUProfilerFrame(frameIndex);
+				Renderer::GetStreamingBuffer().BeginFrame();
+			});
+
+			uint64_t currentTime = GetTime();
+			float timestep = glm::clamp((float)((currentTime - lastTime) * 1e-9), 0.001f, 0.1f);
 			lastTime = currentTime;
 
+			// Replays advance by the same amount every frame so runs are comparable
+			if (m_InputRecorder.IsReplaying())
+				timestep = m_Specification.ReplayTimestep;
+
+			if (m_Specification.Mode == UpdateMode::FixedTimestep)
+				FixedUpdate(timestep);
+
 			// Main layer update here
-			for (const std::unique_ptr<Layer>& layer : m_LayerStack)
-				layer->OnUpdate(timestep);
+			{
+				PROFILE_SCOPE("LayerStack OnUpdate");
+				ScheduleLayerUpdates(m_LayerStack, [timestep](Layer& layer) { layer.OnUpdate(timestep); });
+			}
+
+			m_ElapsedTime += timestep;
 
-			// NOTE: rendering can be done elsewhere (eg. render thread)
+			Renderer::FrameUniforms frameUniforms;
+			frameUniforms.Time = m_ElapsedTime;
+			frameUniforms.DeltaTime = timestep;
+			frameUniforms.FrameIndex = (uint32_t)m_FrameIndex;
+			frameUniforms.Resolution = GetFramebufferSize();
+			frameUniforms.InverseResolution = 1.0f / glm::max(frameUniforms.Resolution, glm::vec2(1.0f));
+			Renderer::Submit([frameUniforms]()
+			{
+				Renderer::FramebufferPool::NextFrame();
+				Renderer::RenderState::BeginFrame();
+				Renderer::BeginFrameUniforms(frameUniforms);
+			});
+
+			Renderer::Submit([budget = m_Specification.TextureUploadBudget]() { Renderer::ProcessTextureUploads(budget); });
+			Renderer::Submit([]() { Renderer::UpdateShaderHotReload(); });
+
+			Renderer::ResetRenderer2DStats();
+
+			Renderer::FrameGraph& frameGraph = GetFrameGraph();
+			frameGraph.Reset();
+
+			const glm::vec2 framebufferSize = GetFramebufferSize();
+			const Renderer::FrameGraphResource backbuffer = frameGraph.ImportBackbuffer("Backbuffer", (uint32_t)framebufferSize.x, (uint32_t)framebufferSize.y);
+			m_SceneColor = frameGraph.CreateTexture("Scene Color", { (uint32_t)framebufferSize.x, (uint32_t)framebufferSize.y, GL_RGBA16F });
+
+			// Layers record render commands here, see Renderer::Submit, and add frame graph passes
 			for (const std::unique_ptr<Layer>& layer : m_LayerStack)
 				layer->OnRender();
 
+			if (frameGraph.IsWritten(m_SceneColor))
+			{
+				const Renderer::FrameGraphResource presented = Renderer::AddPostProcessPasses(frameGraph, m_SceneColor, m_PostProcessSettings);
+
+				frameGraph.AddPass("Present", [presented, backbuffer](Renderer::FrameGraphBuilder& builder)
+				{
+					builder.Read(presented, Renderer::FrameGraphAccess::Transfer);
+					builder.Write(backbuffer, Renderer::FrameGraphAccess::Transfer);
+				},
+				[presented](const Renderer::FrameGraphPassResources& resources)
+				{
+					Renderer::BlitFramebufferToSwapchain(resources.GetFramebuffer(presented));
+				});
+			}
+
+			frameGraph.Compile();
+			m_FrameGraphStats = frameGraph.GetStats();
+			Renderer::Submit([&frameGraph]() { frameGraph.Execute(); });
+
 			m_ImGuiLayer->Begin();
 			{
 				//SE_PROFILE_SCOPE("LayerStack OnImGuiRender");
@@ -96,7 +263,54 @@ namespace Core {
 			}
 			m_ImGuiLayer->End();
 
-			m_Window->Update();
+			// Layers create their shaders on the first frame, report how much the cache saved
+			if (m_FrameIndex == 0)
+				Renderer::Submit([]() { Renderer::LogShaderCacheStats(); });
+
+			Renderer::Submit([window = m_Window.get()]() { window->Update(); });
+			Renderer::Submit([]()
+			{
+				Renderer::GetStreamingBuffer().EndFrame();
+				EndGPUProfilerFrame();
+			});
+
+			// Keeps the driver from queueing frames ahead, see LowLatencyMode
+			if (m_Specification.LowLatencyMode)
+				Renderer::Submit([]() { glFinish(); });
+
+			// Executes this frame's commands, either inline or on the render thread
+			// while the next frame updates
+			m_RenderThread.NextFrame();
+
+			m_FrameProfiler.EndFrame();
+
+			// The GPU time arrives a few frames late, the new scale applies from the next frame
+			m_DynamicResolution.Update(m_FrameProfiler.GetLatestFrame(), m_FrameIndex + 1);
+
+			// This frame's allocations stay alive while the render thread works on it
+			FrameAllocator::NextFrame();
+
+			CheckAllocationBudget();
+
+			PROFILE_MARK_FRAME;
+
+			m_FrameIndex++;
+
+			if (m_Specification.FrameCount > 0 && m_FrameIndex >= m_Specification.FrameCount)
+				Stop();
+		}
+
+		m_InputRecorder.EndRecording(m_FrameIndex);
+
+		m_RenderThread.Terminate();
+
+		// The context is back on this thread, collect the last frames' GPU times
+		m_FrameProfiler.Flush();
+
+		if (m_Specification.Headless && m_FrameIndex > 0)
+		{
+			double seconds = (GetTime() - startTime) * 1e-9;
+			std::println("[Headless] {} frames in {:.2f} s, {:.3f} ms/frame", m_FrameIndex, seconds, seconds * 1000.0 / m_FrameIndex);
 		}
 	}
 
@@ -109,12 +323,97 @@ namespace Core {
 	{
 		for (auto& layer : std::views::reverse(m_LayerStack))
 		{
+			if (!layer->IsSubscribedTo(event))
+				continue;
+
 			layer->OnEvent(event);
 			if (event.Handled)
 				break;
 		}
 	}
 
+	void Application::FixedUpdate(float timestep)
+	{
+		PROFILE_FUNC();
+
+		const float fixedTimestep = 1.0f / m_Specification.FixedUpdateRate;
+
+		m_FixedUpdateAccumulator += timestep;
+
+		uint32_t steps = 0;
+		while (m_FixedUpdateAccumulator >= fixedTimestep && steps < m_Specification.MaxFixedUpdatesPerFrame)
+		{
+			ScheduleLayerUpdates(m_LayerStack, [fixedTimestep](Layer& layer) { layer.OnFixedUpdate(fixedTimestep); });
+			m_FixedUpdateAccumulator -= fixedTimestep;
+			steps++;
+		}
+
+		// Out of catch-up steps, keep only the phase so the next frame doesn't start behind
+		if (m_FixedUpdateAccumulator >= fixedTimestep)
+			m_FixedUpdateAccumulator = std::fmod(m_FixedUpdateAccumulator, fixedTimestep);
+
+		m_FixedUpdateAlpha = m_FixedUpdateAccumulator / fixedTimestep;
+	}
+
+	void Application::CheckAllocationBudget()
+	{
+		m_FrameAllocationStats = EndAllocationFrame();
+
+		const AllocationBudget& budget = m_Specification.FrameAllocationBudget;
+		if (!IsMemoryTrackingAvailable() || m_FrameIndex < budget.WarmupFrames)
+			return;
+
+		const bool overAllocations = budget.MaxAllocations > 0 && m_FrameAllocationStats.Allocations > budget.MaxAllocations;
+		const bool overBytes = budget.MaxBytes > 0 && m_FrameAllocationStats.BytesAllocated > budget.MaxBytes;
+		if (!overAllocations && !overBytes)
+			return;
+
+		// Formatted into the frame arena, the report itself doesn't touch the heap
+		FrameString message;
+		std::format_to(std::back_inserter(message), "[Memory] Frame {} made {} allocations ({} bytes), over the budget of {} allocations / {} bytes",
+			m_FrameIndex, m_FrameAllocationStats.Allocations, m_FrameAllocationStats.BytesAllocated, budget.MaxAllocations, budget.MaxBytes);
+		std::cerr << message << std::endl;
+
+		// Explicitly, an assert would be compiled out of exactly the builds worth profiling
+		if (budget.AssertOnExceeded)
+			std::abort();
+
+		// Don't let the report itself count against the next frame
+		EndAllocationFrame();
+	}
+
+	void Application::QueueLayerTransition(Layer* fromLayer, std::unique_ptr<Layer> toLayer)
+	{
+		std::scoped_lock lock(m_TransitionMutex);
+		m_PendingTransitions.push_back({ fromLayer, std::move(toLayer) });
+	}
+
+	void Application::ApplyLayerTransitions()
+	{
+		std::scoped_lock lock(m_TransitionMutex);
+
+		if (m_PendingTransitions.empty())
+			return;
+
+		// Outgoing layers may read GL handles their render commands filled in,
+		// so let the render thread catch up before destroying them
+		m_RenderThread.WaitIdle();
+
+		for (LayerTransition& transition : m_PendingTransitions)
+		{
+			for (auto& layer : m_LayerStack)
+			{
+				if (layer.get() == transition.From)
+				{
+					layer = std::move(transition.To);
+					break;
+				}
+			}
+		}
+
+		m_PendingTransitions.clear();
+	}
+
 	glm::vec2 Application::GetFramebufferSize() const
 	{
 		return m_Window->GetFramebufferSize();
@@ -126,9 +425,10 @@ namespace Core {
 		return *s_Application;
 	}
 
-	float Application::GetTime()
+	uint64_t Application::GetTime()
 	{
-		return (float)glfwGetTime();
+		static const auto start = std::chrono::steady_clock::now();
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
 	}
 
 }
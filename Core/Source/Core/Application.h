@@ -2,23 +2,101 @@
 
 #include "Window.h"
 #include "Event.h"
+#include "EventQueue.h"
+#include "Debug/FrameProfiler.h"
+#include "Debug/MemoryTracker.h"
+#include "FramePacer.h"
+#include "InputRecorder.h"
+#include "RenderThread.h"
+#include "Renderer/DynamicResolution.h"
+#include "Renderer/FrameGraph.h"
+#include "Renderer/PostProcessing.h"
 
 #include "ImGui/ImGuiLayer.h"
 
 #include <glm/glm.hpp>
 
+#include <filesystem>
 #include <string>
 #include <memory>
 #include <vector>
 #include <set>
 #include <functional>
+#include <mutex>
 
 namespace Core {
 
+	enum class UpdateMode
+	{
+		Variable,     // OnUpdate only, with the frame's delta time
+		FixedTimestep // OnFixedUpdate at a fixed rate, then OnUpdate with the frame's delta time
+	};
+
 	struct ApplicationSpecification
 	{
 		std::string Name = "Application";
 		WindowSpecification WindowSpec;
+
+		// The simulation rate is independent of the frame rate in FixedTimestep mode. Render
+		// between fixed steps with Application::GetFixedUpdateAlpha.
+		UpdateMode Mode = UpdateMode::Variable;
+		float FixedUpdateRate = 60.0f;
+		// Frames that fall further behind drop the remaining time instead of spiraling
+		uint32_t MaxFixedUpdatesPerFrame = 5;
+
+		// Frame rate cap enforced on the CPU, 0 = unlimited. Independent of WindowSpec.Present.
+		uint32_t TargetFrameRate = 0;
+		// Waits for the previous frame to reach the GPU and finish before polling input, so
+		// input is sampled as late as possible. Trades throughput for input-to-photon latency.
+		bool LowLatencyMode = false;
+
+		// Runs without a display on GLFW's null platform with an offscreen EGL (or OSMesa)
+		// GL 4.6 context. Frames are presented into Renderer::GetBackbuffer() as usual.
+		bool Headless = false;
+		// Stops after this many frames, 0 runs until the window closes or Stop is called
+		uint64_t FrameCount = 0;
+
+		// Most recent frames whose CPU and GPU times the FrameProfiler keeps
+		size_t FrameTimingHistory = 1024;
+
+		// Checked every frame when built with memory tracking, see MemoryTracker.h
+		AllocationBudget FrameAllocationBudget;
+
+		// Bytes each thread's FrameAllocator arena holds, two arenas per thread for frames in flight
+		size_t FrameArenaSize = 1024 * 1024;
+
+		// Job system workers, 0 = one per hardware thread minus the main thread
+		uint32_t WorkerThreadCount = 0;
+
+		// Hands the GL context to a dedicated thread that executes the previous frame's
+		// render commands while the next frame updates. ImGui multi-viewports are disabled.
+		bool UseRenderThread = false;
+
+		// Per-frame region of Renderer::GetStreamingBuffer, three regions are kept for frames in flight
+		uint64_t StreamingBufferSize = 16 * 1024 * 1024;
+
+		// Render scale of the passes that opt in, see Application::GetDynamicResolution
+		Renderer::DynamicResolutionSettings DynamicResolution;
+
+		// Effects applied to the scene color before it's presented, see Application::GetPostProcessSettings
+		Renderer::PostProcessSettings PostProcess;
+
+		// Upper bound on texture data Renderer::LoadTextureAsync copies to the GPU per frame
+		uint64_t TextureUploadBudget = 8 * 1024 * 1024;
+
+		// Linked program binaries are cached here between runs, empty disables the cache
+		std::filesystem::path ShaderCacheDirectory = "Cache/Shaders";
+
+		// Shaders registered with Renderer::Watch*Shader are rebuilt in the background when
+		// files under this directory change, empty disables hot reloading
+		std::filesystem::path ShaderHotReloadDirectory = "Resources/Shaders";
+
+		// Window events are written here when set, see InputRecorder
+		std::filesystem::path InputRecordPath;
+		// Plays a recording back instead of live input, stepping every frame by ReplayTimestep.
+		// The application stops after the last recorded frame.
+		std::filesystem::path InputReplayPath;
+		float ReplayTimestep = 1.0f / 60.0f;
 	};
 
 	class Application
@@ -60,16 +138,77 @@ namespace Core {
 
 		ImGuiLayer* GetImGuiLayer() { return m_ImGuiLayer; }
 
+		const EventQueueStats& GetEventQueueStats() const { return m_EventQueue.GetLastFrameStats(); }
+
+		FrameProfiler& GetFrameProfiler() { return m_FrameProfiler; }
+
+		// Layers add their passes in OnRender, the graph is compiled and executed after the last layer's
+		Renderer::FrameGraph& GetFrameGraph() { return m_FrameGraphs[m_FrameIndex % 2]; }
+		// Framebuffer-sized HDR target in the frame graph, post-processed and blitted to the
+		// backbuffer once a pass writes it
+		Renderer::FrameGraphResource GetSceneColor() const { return m_SceneColor; }
+		const Renderer::FrameGraphStats& GetFrameGraphStats() const { return m_FrameGraphStats; }
+
+		// Scale for heavy passes, updated every frame from the GPU frame time. Passes render into
+		// a target of GetScaledSize and upscale it with Renderer::AddUpscalePass.
+		Renderer::DynamicResolution& GetDynamicResolution() { return m_DynamicResolution; }
+
+		// Starts out as the specification's, changes apply from the next frame
+		Renderer::PostProcessSettings& GetPostProcessSettings() { return m_PostProcessSettings; }
+
+		// Heap allocations made during the previous frame, all zero without memory tracking
+		const AllocationStats& GetFrameAllocationStats() const { return m_FrameAllocationStats; }
+
+		const ApplicationSpecification& GetSpecification() const { return m_Specification; }
+
+		// How far the current frame is between the last fixed update and the next one, in [0, 1)
+		float GetFixedUpdateAlpha() const { return m_FixedUpdateAlpha; }
+
 		static Application& Get();
-		static float GetTime();
+		// Nanoseconds on a monotonic clock, counted from the first call
+		static uint64_t GetTime();
+	private:
+		void FixedUpdate(float timestep);
+		void CheckAllocationBudget();
+
+		void QueueLayerTransition(Layer* fromLayer, std::unique_ptr<Layer> toLayer);
+		void ApplyLayerTransitions();
 	private:
 		ApplicationSpecification m_Specification;
 		std::shared_ptr<Window> m_Window;
 		ImGuiLayer* m_ImGuiLayer;
+		RenderThread m_RenderThread;
+		EventQueue m_EventQueue;
+		InputRecorder m_InputRecorder;
+		FramePacer m_FramePacer;
+		FrameProfiler m_FrameProfiler;
+		AllocationStats m_FrameAllocationStats;
+
+		// One is built while the render thread executes the other
+		Renderer::FrameGraph m_FrameGraphs[2];
+		Renderer::FrameGraphResource m_SceneColor = Renderer::InvalidFrameGraphResource;
+		Renderer::FrameGraphStats m_FrameGraphStats;
+
+		Renderer::DynamicResolution m_DynamicResolution;
+		Renderer::PostProcessSettings m_PostProcessSettings;
+
+		uint64_t m_FrameIndex = 0;
+		float m_ElapsedTime = 0.0f; // Sum of the timesteps, the frame block's time
+
+		float m_FixedUpdateAccumulator = 0.0f;
+		float m_FixedUpdateAlpha = 0.0f;
 		bool m_Running = false;
 
 		std::vector<std::unique_ptr<Layer>> m_LayerStack;
 
+		struct LayerTransition
+		{
+			Layer* From;
+			std::unique_ptr<Layer> To;
+		};
+		std::vector<LayerTransition> m_PendingTransitions;
+		std::mutex m_TransitionMutex;
+
 		friend class Layer;
 	};
 
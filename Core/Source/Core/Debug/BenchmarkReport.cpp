@@ -0,0 +1,189 @@
+#include "BenchmarkReport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace Core {
+
+	static TimingSummary Summarize(std::vector<double> values)
+	{
+		TimingSummary summary;
+		if (values.empty())
+			return summary;
+
+		std::sort(values.begin(), values.end());
+
+		auto percentile = [&values](double p)
+		{
+			size_t rank = (size_t)std::ceil(p * values.size());
+			return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+		};
+
+		double sum = 0.0;
+		for (double value : values)
+			sum += value;
+
+		summary.Mean = sum / values.size();
+		summary.P50 = percentile(0.50);
+		summary.P95 = percentile(0.95);
+		summary.P99 = percentile(0.99);
+		summary.Max = values.back();
+		return summary;
+	}
+
+	static std::ofstream OpenOutput(const std::filesystem::path& path)
+	{
+		std::error_code error;
+		if (path.has_parent_path())
+			std::filesystem::create_directories(path.parent_path(), error);
+
+		std::ofstream file(path, std::ios::trunc);
+		if (!file.is_open())
+			std::cerr << "Failed to open benchmark output: " << path.string() << std::endl;
+		return file;
+	}
+
+	static std::string SummaryToJson(const TimingSummary& summary)
+	{
+		return std::format("{{ \"mean\": {:.4f}, \"p50\": {:.4f}, \"p95\": {:.4f}, \"p99\": {:.4f}, \"max\": {:.4f} }}",
+			summary.Mean, summary.P50, summary.P95, summary.P99, summary.Max);
+	}
+
+	BenchmarkReport CreateBenchmarkReport(const std::string& scenario, const std::vector<FrameTiming>& frames, uint64_t warmupFrames)
+	{
+		BenchmarkReport report;
+		report.Scenario = scenario;
+		report.WarmupFrames = warmupFrames;
+
+		for (const FrameTiming& frame : frames)
+		{
+			if (frame.FrameIndex >= warmupFrames)
+				report.Frames.push_back(frame);
+		}
+
+		std::vector<double> cpu, gpu;
+		cpu.reserve(report.Frames.size());
+		gpu.reserve(report.Frames.size());
+		for (const FrameTiming& frame : report.Frames)
+		{
+			cpu.push_back(frame.CPUMillis);
+			if (frame.GPUMillis >= 0.0)
+				gpu.push_back(frame.GPUMillis);
+		}
+
+		report.CPU = Summarize(cpu);
+		report.HasGPU = !gpu.empty() && gpu.size() == cpu.size();
+		if (report.HasGPU)
+			report.GPU = Summarize(gpu);
+
+		return report;
+	}
+
+	bool WriteBenchmarkJson(const BenchmarkReport& report, const std::filesystem::path& path)
+	{
+		std::ofstream file = OpenOutput(path);
+		if (!file.is_open())
+			return false;
+
+		file << "{\n";
+		file << std::format("\t\"scenario\": \"{}\",\n", report.Scenario);
+		file << std::format("\t\"warmup_frames\": {},\n", report.WarmupFrames);
+		file << std::format("\t\"frames\": {},\n", report.Frames.size());
+		file << "\t\"cpu_ms\": " << SummaryToJson(report.CPU) << ",\n";
+		file << "\t\"gpu_ms\": " << (report.HasGPU ? SummaryToJson(report.GPU) : "null") << "\n";
+		file << "}\n";
+		return true;
+	}
+
+	bool WriteBenchmarkCsv(const BenchmarkReport& report, const std::filesystem::path& path)
+	{
+		std::ofstream file = OpenOutput(path);
+		if (!file.is_open())
+			return false;
+
+		file << "frame,cpu_ms,gpu_ms\n";
+		for (const FrameTiming& frame : report.Frames)
+		{
+			if (frame.GPUMillis >= 0.0)
+				file << std::format("{},{:.4f},{:.4f}\n", frame.FrameIndex, frame.CPUMillis, frame.GPUMillis);
+			else
+				file << std::format("{},{:.4f},\n", frame.FrameIndex, frame.CPUMillis);
+		}
+		return true;
+	}
+
+	std::vector<std::string> CheckBenchmarkThresholds(const BenchmarkReport& report, const std::filesystem::path& path)
+	{
+		std::vector<std::string> violations;
+
+		std::ifstream file(path);
+		if (!file.is_open())
+		{
+			violations.push_back(std::format("Failed to open threshold file: {}", path.string()));
+			return violations;
+		}
+
+		std::string line;
+		uint32_t lineNumber = 0;
+		while (std::getline(file, line))
+		{
+			lineNumber++;
+
+			if (size_t comment = line.find('#'); comment != std::string::npos)
+				line.erase(comment);
+
+			std::istringstream stream(line);
+			std::string scenario, metric;
+			double limit = 0.0;
+			if (!(stream >> scenario))
+				continue;
+
+			if (!(stream >> metric >> limit))
+			{
+				std::cerr << std::format("{}:{}: expected '<scenario> <metric> <milliseconds>'", path.string(), lineNumber) << std::endl;
+				continue;
+			}
+
+			if (scenario != "*" && scenario != report.Scenario)
+				continue;
+
+			const bool isGPU = metric.starts_with("gpu_");
+			if (!isGPU && !metric.starts_with("cpu_"))
+			{
+				std::cerr << std::format("{}:{}: unknown metric '{}'", path.string(), lineNumber, metric) << std::endl;
+				continue;
+			}
+
+			if (isGPU && !report.HasGPU)
+			{
+				std::cerr << std::format("{}:{}: no GPU timings, skipping '{}'", path.string(), lineNumber, metric) << std::endl;
+				continue;
+			}
+
+			const TimingSummary& summary = isGPU ? report.GPU : report.CPU;
+			const std::string statistic = metric.substr(4);
+
+			double value = 0.0;
+			if (statistic == "mean")     value = summary.Mean;
+			else if (statistic == "p50") value = summary.P50;
+			else if (statistic == "p95") value = summary.P95;
+			else if (statistic == "p99") value = summary.P99;
+			else if (statistic == "max") value = summary.Max;
+			else
+			{
+				std::cerr << std::format("{}:{}: unknown metric '{}'", path.string(), lineNumber, metric) << std::endl;
+				continue;
+			}
+
+			if (value > limit)
+				violations.push_back(std::format("{} {:.3f} ms exceeds {:.3f} ms", metric, value, limit));
+		}
+
+		return violations;
+	}
+
+}
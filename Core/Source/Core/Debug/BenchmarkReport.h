@@ -0,0 +1,43 @@
+#pragma once
+
+#include "FrameProfiler.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Core {
+
+	struct TimingSummary
+	{
+		double Mean = 0.0;
+		double P50 = 0.0;
+		double P95 = 0.0;
+		double P99 = 0.0;
+		double Max = 0.0;
+	};
+
+	struct BenchmarkReport
+	{
+		std::string Scenario;
+		uint64_t WarmupFrames = 0;
+		std::vector<FrameTiming> Frames; // Measured frames only
+
+		TimingSummary CPU;
+		TimingSummary GPU;
+		bool HasGPU = false; // Every measured frame has a GPU time
+	};
+
+	// Summarizes the frames from warmupFrames on, percentiles are nearest-rank
+	BenchmarkReport CreateBenchmarkReport(const std::string& scenario, const std::vector<FrameTiming>& frames, uint64_t warmupFrames);
+
+	bool WriteBenchmarkJson(const BenchmarkReport& report, const std::filesystem::path& path);
+	// One row per measured frame: frame,cpu_ms,gpu_ms
+	bool WriteBenchmarkCsv(const BenchmarkReport& report, const std::filesystem::path& path);
+
+	// Threshold files hold one limit per line, '#' starts a comment:
+	//   <scenario or *> <cpu|gpu>_<mean|p50|p95|p99|max> <milliseconds>
+	// Returns a description of every limit the report exceeds.
+	std::vector<std::string> CheckBenchmarkThresholds(const BenchmarkReport& report, const std::filesystem::path& path);
+
+}
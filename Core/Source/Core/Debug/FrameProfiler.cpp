@@ -0,0 +1,72 @@
+#include "FrameProfiler.h"
+
+#include "Core/Application.h"
+
+#include "Profiler.h"
+
+namespace Core {
+
+	// Frames only get this far behind when the GPU results never come, e.g. timer queries unsupported
+	static constexpr size_t MaxPendingFrames = 16;
+
+	void FrameProfiler::BeginFrame(uint64_t frameIndex)
+	{
+		m_FrameIndex = frameIndex;
+		m_CPUStart = Application::GetTime();
+	}
+
+	void FrameProfiler::EndFrame()
+	{
+		m_PendingFrames.push_back({ m_FrameIndex, (Application::GetTime() - m_CPUStart) * 1e-6 });
+
+		MergeGPUResults();
+
+		// Results arrive in order, so only the front can be complete
+		while (!m_PendingFrames.empty() && (m_PendingFrames.front().GPUMillis >= 0.0 || m_PendingFrames.size() > MaxPendingFrames))
+		{
+			m_History.push_back(m_PendingFrames.front());
+			m_PendingFrames.pop_front();
+		}
+
+		while (m_History.size() > m_HistoryLimit)
+			m_History.pop_front();
+	}
+
+	std::vector<FrameTiming> FrameProfiler::GetHistory()
+	{
+		return std::vector<FrameTiming>(m_History.begin(), m_History.end());
+	}
+
+	void FrameProfiler::Flush()
+	{
+		PROFILE_FUNC();
+
+		FlushGPUProfiler();
+
+		MergeGPUResults();
+
+		m_History.insert(m_History.end(), m_PendingFrames.begin(), m_PendingFrames.end());
+		m_PendingFrames.clear();
+
+		while (m_History.size() > m_HistoryLimit)
+			m_History.pop_front();
+	}
+
+	void FrameProfiler::MergeGPUResults()
+	{
+		TakeGPUFrameTimes(m_GPUResults);
+		for (const GPUFrameTime& result : m_GPUResults)
+		{
+			for (FrameTiming& frame : m_PendingFrames)
+			{
+				if (frame.FrameIndex == result.FrameIndex)
+				{
+					frame.GPUMillis = result.Millis;
+					break;
+				}
+			}
+		}
+		m_GPUResults.clear();
+	}
+
+}
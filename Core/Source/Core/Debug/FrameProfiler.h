@@ -0,0 +1,50 @@
+#pragma once
+
+#include "GPUProfiler.h"
+
+#include <deque>
+#include <stdint.h>
+#include <vector>
+
+namespace Core {
+
+	struct FrameTiming
+	{
+		uint64_t FrameIndex = 0;
+		double CPUMillis = 0.0;  // Main thread, excluding the frame pacer's wait
+		double GPUMillis = -1.0; // First to last command of the frame on the GPU, negative until known
+	};
+
+	// Measures every frame's CPU time and pairs it with the GPU time the GPU profiler reads
+	// back a few frames late, see BeginGPUProfilerFrame, without ever stalling on the GPU.
+	class FrameProfiler
+	{
+	public:
+		// Completed frames kept for GetHistory, oldest are dropped first
+		void SetHistoryLimit(size_t limit) { m_HistoryLimit = limit; }
+
+		// Main thread
+		void BeginFrame(uint64_t frameIndex);
+		void EndFrame();
+
+		// Frames whose GPU time has arrived, oldest first
+		std::vector<FrameTiming> GetHistory();
+		// Newest of those, GPUMillis is negative while there's none
+		FrameTiming GetLatestFrame() const { return m_History.empty() ? FrameTiming() : m_History.back(); }
+
+		// Waits for every outstanding GPU result. Needs the context current on the calling
+		// thread, Application::Run does this on exit.
+		void Flush();
+	private:
+		void MergeGPUResults();
+	private:
+		uint64_t m_FrameIndex = 0;
+		uint64_t m_CPUStart = 0;
+		std::deque<FrameTiming> m_PendingFrames; // CPU time known, waiting on the GPU
+		std::deque<FrameTiming> m_History;
+		size_t m_HistoryLimit = 1024;
+
+		std::vector<GPUFrameTime> m_GPUResults; // Reused by MergeGPUResults
+	};
+
+}
@@ -0,0 +1,264 @@
+#include "GPUProfiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+namespace Core {
+
+	static constexpr uint32_t FramesInFlight = 4;
+	static constexpr uint32_t MaxZonesPerFrame = 64;
+	static constexpr uint32_t InvalidZone = ~0u;
+	// Frame times kept when nobody takes them
+	static constexpr size_t MaxFrameTimes = 64;
+
+	// Frames between resets of GPUPassTiming::MaxMillis
+	static constexpr uint32_t MaxWindowFrames = 240;
+	static constexpr double AverageWeight = 0.05;
+
+	struct FrameQueries
+	{
+		GLuint FrameBounds[2] = {}; // Frame begin and end timestamps, the end is issued last
+		GLuint Queries[MaxZonesPerFrame * 2] = {}; // Begin and end timestamp per zone
+		const char* Names[MaxZonesPerFrame] = {};
+		uint32_t ZoneCount = 0;
+		uint64_t FrameIndex = 0; // The application's
+		bool InFlight = false;
+	};
+
+	struct PassStats
+	{
+		GPUPassTiming Timing;
+		double WindowMax = 0.0;
+		uint64_t Samples = 0;
+	};
+
+	struct GPUProfilerData
+	{
+		// GL thread
+		FrameQueries Frames[FramesInFlight];
+		uint32_t RingIndex = 0;
+		bool Initialized = false;
+		bool FrameActive = false;
+
+		std::mutex StatsMutex;
+		std::vector<PassStats> Passes;
+		std::vector<GPUFrameTime> FrameTimes;
+		uint32_t WindowFrames = 0;
+	};
+
+	static GPUProfilerData s_Data;
+
+	static PassStats& FindPass(const char* name)
+	{
+		for (PassStats& pass : s_Data.Passes)
+		{
+			if (pass.Timing.Name == name || std::strcmp(pass.Timing.Name, name) == 0)
+				return pass;
+		}
+
+		PassStats& pass = s_Data.Passes.emplace_back();
+		pass.Timing.Name = name;
+		return pass;
+	}
+
+	// Returns false without blocking if wait is false and the GPU hasn't reached the end of the frame
+	static bool ReadBack(FrameQueries& frame, bool wait)
+	{
+		if (!wait)
+		{
+			// Timestamps complete in order, the frame end being there means they all are
+			GLint available = GL_FALSE;
+			glGetQueryObjectiv(frame.FrameBounds[1], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				return false;
+		}
+
+		GLuint64 frameBegin = 0, frameEnd = 0;
+		glGetQueryObjectui64v(frame.FrameBounds[0], GL_QUERY_RESULT, &frameBegin);
+		glGetQueryObjectui64v(frame.FrameBounds[1], GL_QUERY_RESULT, &frameEnd);
+		const double frameMillis = frameEnd > frameBegin ? (frameEnd - frameBegin) * 1e-6 : 0.0;
+
+		// Passes recorded more than once in a frame are added up
+		const char* names[MaxZonesPerFrame];
+		double millis[MaxZonesPerFrame];
+		uint32_t passCount = 0;
+
+		for (uint32_t zone = 0; zone < frame.ZoneCount; zone++)
+		{
+			GLuint64 begin = 0, end = 0;
+			glGetQueryObjectui64v(frame.Queries[zone * 2 + 0], GL_QUERY_RESULT, &begin);
+			glGetQueryObjectui64v(frame.Queries[zone * 2 + 1], GL_QUERY_RESULT, &end);
+			const double zoneMillis = end > begin ? (end - begin) * 1e-6 : 0.0;
+
+			uint32_t pass = 0;
+			while (pass < passCount && names[pass] != frame.Names[zone])
+				pass++;
+
+			if (pass == passCount)
+			{
+				names[passCount] = frame.Names[zone];
+				millis[passCount++] = 0.0;
+			}
+			millis[pass] += zoneMillis;
+		}
+
+		frame.InFlight = false;
+
+		std::scoped_lock lock(s_Data.StatsMutex);
+
+		if (s_Data.FrameTimes.size() == MaxFrameTimes)
+			s_Data.FrameTimes.erase(s_Data.FrameTimes.begin());
+		s_Data.FrameTimes.push_back({ frame.FrameIndex, frameMillis });
+
+		const bool resetWindow = ++s_Data.WindowFrames >= MaxWindowFrames;
+		if (resetWindow)
+			s_Data.WindowFrames = 0;
+
+		for (uint32_t i = 0; i < passCount; i++)
+		{
+			PassStats& pass = FindPass(names[i]);
+			GPUPassTiming& timing = pass.Timing;
+
+			timing.AverageMillis = pass.Samples++ == 0 ? millis[i] : timing.AverageMillis + (millis[i] - timing.AverageMillis) * AverageWeight;
+			timing.LastMillis = millis[i];
+			timing.MaxMillis = std::max(timing.MaxMillis, millis[i]);
+
+			pass.WindowMax = std::max(pass.WindowMax, millis[i]);
+		}
+
+		if (resetWindow)
+		{
+			for (PassStats& pass : s_Data.Passes)
+			{
+				pass.Timing.MaxMillis = pass.WindowMax;
+				pass.WindowMax = 0.0;
+			}
+		}
+
+		return true;
+	}
+
+	void BeginGPUProfilerFrame(uint64_t frameIndex)
+	{
+		if (!s_Data.Initialized)
+		{
+			for (FrameQueries& frame : s_Data.Frames)
+			{
+				glGenQueries(2, frame.FrameBounds);
+				glGenQueries(MaxZonesPerFrame * 2, frame.Queries);
+			}
+
+			// Here rather than at startup so the Tracy context lives on the GL thread
+#if ENABLE_PROFILING
+			TracyGpuContext;
+#endif
+			s_Data.Initialized = true;
+		}
+
+		FrameQueries& frame = s_Data.Frames[s_Data.RingIndex];
+
+		// The GPU is a whole ring behind, only now is waiting unavoidable
+		if (frame.InFlight)
+			ReadBack(frame, true);
+
+		frame.ZoneCount = 0;
+		frame.FrameIndex = frameIndex;
+		glQueryCounter(frame.FrameBounds[0], GL_TIMESTAMP);
+		s_Data.FrameActive = true;
+	}
+
+	void EndGPUProfilerFrame()
+	{
+		if (!s_Data.FrameActive)
+			return;
+
+		FrameQueries& frame = s_Data.Frames[s_Data.RingIndex];
+		glQueryCounter(frame.FrameBounds[1], GL_TIMESTAMP);
+		frame.InFlight = true;
+		s_Data.FrameActive = false;
+		s_Data.RingIndex = (s_Data.RingIndex + 1) % FramesInFlight;
+
+#if ENABLE_PROFILING
+		TracyGpuCollect;
+#endif
+
+		// Oldest first, stop at the first frame the GPU is still working on
+		for (uint32_t i = 0; i < FramesInFlight; i++)
+		{
+			FrameQueries& pending = s_Data.Frames[(s_Data.RingIndex + i) % FramesInFlight];
+			if (pending.InFlight && !ReadBack(pending, false))
+				break;
+		}
+	}
+
+	void FlushGPUProfiler()
+	{
+		for (uint32_t i = 0; i < FramesInFlight; i++)
+		{
+			FrameQueries& pending = s_Data.Frames[(s_Data.RingIndex + i) % FramesInFlight];
+			if (pending.InFlight)
+				ReadBack(pending, true);
+		}
+	}
+
+	void ShutdownGPUProfiler()
+	{
+		if (!s_Data.Initialized)
+			return;
+
+		for (FrameQueries& frame : s_Data.Frames)
+		{
+			glDeleteQueries(2, frame.FrameBounds);
+			glDeleteQueries(MaxZonesPerFrame * 2, frame.Queries);
+			frame.InFlight = false;
+		}
+
+		s_Data.Initialized = false;
+		s_Data.FrameActive = false;
+	}
+
+	uint32_t BeginGPUZone(const char* name)
+	{
+		if (!s_Data.FrameActive)
+			return InvalidZone;
+
+		FrameQueries& frame = s_Data.Frames[s_Data.RingIndex];
+		if (frame.ZoneCount == MaxZonesPerFrame)
+			return InvalidZone;
+
+		const uint32_t zone = frame.ZoneCount++;
+		frame.Names[zone] = name;
+		glQueryCounter(frame.Queries[zone * 2 + 0], GL_TIMESTAMP);
+		return zone;
+	}
+
+	void EndGPUZone(uint32_t zone)
+	{
+		if (zone == InvalidZone || !s_Data.FrameActive)
+			return;
+
+		FrameQueries& frame = s_Data.Frames[s_Data.RingIndex];
+		glQueryCounter(frame.Queries[zone * 2 + 1], GL_TIMESTAMP);
+	}
+
+	std::vector<GPUPassTiming> GetGPUPassTimings()
+	{
+		std::scoped_lock lock(s_Data.StatsMutex);
+
+		std::vector<GPUPassTiming> result;
+		result.reserve(s_Data.Passes.size());
+		for (const PassStats& pass : s_Data.Passes)
+			result.push_back(pass.Timing);
+		return result;
+	}
+
+	void TakeGPUFrameTimes(std::vector<GPUFrameTime>& frameTimes)
+	{
+		std::scoped_lock lock(s_Data.StatsMutex);
+
+		frameTimes.insert(frameTimes.end(), s_Data.FrameTimes.begin(), s_Data.FrameTimes.end());
+		s_Data.FrameTimes.clear();
+	}
+
+}
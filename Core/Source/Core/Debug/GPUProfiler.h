@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Profiler.h"
+
+#include <glad/glad.h>
+
+#if ENABLE_PROFILING
+#include <tracy/TracyOpenGL.hpp>
+#endif
+
+#include <stdint.h>
+#include <vector>
+
+namespace Core {
+
+	struct GPUPassTiming
+	{
+		const char* Name = nullptr;
+		double LastMillis = 0.0;
+		double AverageMillis = 0.0; // Exponential moving average
+		double MaxMillis = 0.0;     // Over the last few seconds of frames
+	};
+
+	struct GPUFrameTime
+	{
+		uint64_t FrameIndex = 0;
+		double Millis = 0.0; // First to last command of the frame
+	};
+
+	// GPU timestamps for the whole frame and for named passes, recorded into a ring of
+	// GL_TIMESTAMP queries that is read back a few frames late so the CPU never waits on
+	// the GPU. The frame and zone functions are GL thread only, Application calls the frame ones.
+	void BeginGPUProfilerFrame(uint64_t frameIndex);
+	void EndGPUProfilerFrame();
+	// Waits for every frame still in flight, e.g. before reading the last frame times on exit
+	void FlushGPUProfiler();
+	void ShutdownGPUProfiler();
+
+	// name must outlive the profiler, i.e. a string literal. Zones outside a frame are dropped.
+	uint32_t BeginGPUZone(const char* name);
+	void EndGPUZone(uint32_t zone);
+
+	// Every pass seen so far, in first-seen order. Safe to call from any thread.
+	std::vector<GPUPassTiming> GetGPUPassTimings();
+	// Appends the frame times read back since the last call, oldest first. Safe to call from any thread.
+	void TakeGPUFrameTimes(std::vector<GPUFrameTime>& frameTimes);
+
+	class GPUScope
+	{
+	public:
+		GPUScope(const char* name) : m_Zone(BeginGPUZone(name)) {}
+		~GPUScope() { EndGPUZone(m_Zone); }
+
+		GPUScope(const GPUScope&) = delete;
+		GPUScope& operator=(const GPUScope&) = delete;
+	private:
+		uint32_t m_Zone;
+	};
+
+}
+
+// Times the GL commands issued in the enclosing scope on the GL thread, e.g. inside a Renderer::Submit.
+// The in-process timings are kept in every build, only the Tracy zone goes with profiling.
+#if ENABLE_PROFILING
+#define PROFILE_GPU_SCOPE(NAME)		TracyGpuZone(NAME); ::Core::GPUScope ___gpu_scope(NAME)
+#else
+#define PROFILE_GPU_SCOPE(NAME)		::Core::GPUScope ___gpu_scope(NAME)
+#endif
@@ -0,0 +1,203 @@
+#include "MemoryTracker.h"
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace Core {
+
+	static constexpr uint32_t MaxTrackedThreads = 64;
+	// Frames of callstack Tracy captures per allocation
+	static constexpr int MemoryCallstackDepth = 8;
+
+	struct ThreadSlot
+	{
+		char Name[32] = {};
+		std::atomic<uint64_t> Allocations = 0;
+		std::atomic<uint64_t> Frees = 0;
+		std::atomic<uint64_t> BytesAllocated = 0;
+		std::atomic<uint64_t> BytesFreed = 0;
+	};
+
+	struct MemoryTrackerData
+	{
+		std::atomic<bool> Tracking = false;
+
+		// Current frame, all threads
+		std::atomic<uint64_t> FrameAllocations = 0;
+		std::atomic<uint64_t> FrameFrees = 0;
+		std::atomic<uint64_t> FrameBytesAllocated = 0;
+		std::atomic<uint64_t> FrameBytesFreed = 0;
+
+		std::atomic<int64_t> LiveBytes = 0;
+
+		// The last slot is shared by every thread past MaxTrackedThreads - 1
+		ThreadSlot Threads[MaxTrackedThreads];
+		std::atomic<uint32_t> ThreadCount = 0;
+	};
+
+	// Constant-initialized, so it's usable from allocations made during static initialization
+	static constinit MemoryTrackerData s_Data;
+
+	static thread_local ThreadSlot* t_ThreadSlot = nullptr;
+
+	static ThreadSlot& GetThreadSlot()
+	{
+		if (!t_ThreadSlot)
+		{
+			uint32_t index = s_Data.ThreadCount.fetch_add(1, std::memory_order_relaxed);
+			t_ThreadSlot = &s_Data.Threads[std::min(index, MaxTrackedThreads - 1)];
+		}
+		return *t_ThreadSlot;
+	}
+
+	void StartMemoryTracking()
+	{
+		s_Data.Tracking.store(ENABLE_MEMORY_TRACKING, std::memory_order_relaxed);
+	}
+
+	AllocationStats EndAllocationFrame()
+	{
+		AllocationStats stats;
+		stats.Allocations = s_Data.FrameAllocations.exchange(0, std::memory_order_relaxed);
+		stats.Frees = s_Data.FrameFrees.exchange(0, std::memory_order_relaxed);
+		stats.BytesAllocated = s_Data.FrameBytesAllocated.exchange(0, std::memory_order_relaxed);
+		stats.BytesFreed = s_Data.FrameBytesFreed.exchange(0, std::memory_order_relaxed);
+		return stats;
+	}
+
+	void SetAllocationThreadName(const char* name)
+	{
+		ThreadSlot& slot = GetThreadSlot();
+		std::strncpy(slot.Name, name, sizeof(slot.Name) - 1);
+	}
+
+	std::vector<ThreadAllocationStats> GetThreadAllocationStats()
+	{
+		const uint32_t threadCount = std::min(s_Data.ThreadCount.load(std::memory_order_relaxed), MaxTrackedThreads);
+
+		std::vector<ThreadAllocationStats> result(threadCount);
+		for (uint32_t i = 0; i < threadCount; i++)
+		{
+			const ThreadSlot& slot = s_Data.Threads[i];
+			std::memcpy(result[i].Name, slot.Name, sizeof(slot.Name));
+			result[i].Total.Allocations = slot.Allocations.load(std::memory_order_relaxed);
+			result[i].Total.Frees = slot.Frees.load(std::memory_order_relaxed);
+			result[i].Total.BytesAllocated = slot.BytesAllocated.load(std::memory_order_relaxed);
+			result[i].Total.BytesFreed = slot.BytesFreed.load(std::memory_order_relaxed);
+		}
+		return result;
+	}
+
+	uint64_t GetLiveAllocationBytes()
+	{
+		return (uint64_t)std::max<int64_t>(s_Data.LiveBytes.load(std::memory_order_relaxed), 0);
+	}
+
+#if ENABLE_MEMORY_TRACKING
+
+	// Sits right in front of every block handed out, lets delete find the size and the
+	// start of the underlying malloc block
+	struct AllocationHeader
+	{
+		uint64_t Size;
+		uint32_t Offset;  // From the malloc block to the returned pointer
+		uint32_t Tracked; // Allocated while tracking, frees of untracked blocks aren't reported
+	};
+	static_assert(sizeof(AllocationHeader) == 16);
+
+	static void* Allocate(size_t size, size_t alignment)
+	{
+		alignment = std::max(alignment, sizeof(AllocationHeader));
+
+		// malloc returns 16 byte aligned blocks, the header fits in the padding
+		uint8_t* block = (uint8_t*)std::malloc(size + alignment);
+		if (!block)
+			return nullptr;
+
+		uint8_t* memory = (uint8_t*)(((uintptr_t)block + sizeof(AllocationHeader) + alignment - 1) & ~(uintptr_t)(alignment - 1));
+
+		const bool tracked = s_Data.Tracking.load(std::memory_order_relaxed);
+
+		AllocationHeader* header = (AllocationHeader*)memory - 1;
+		header->Size = size;
+		header->Offset = (uint32_t)(memory - block);
+		header->Tracked = tracked;
+
+		if (tracked)
+		{
+			ThreadSlot& slot = GetThreadSlot();
+			slot.Allocations.fetch_add(1, std::memory_order_relaxed);
+			slot.BytesAllocated.fetch_add(size, std::memory_order_relaxed);
+
+			s_Data.FrameAllocations.fetch_add(1, std::memory_order_relaxed);
+			s_Data.FrameBytesAllocated.fetch_add(size, std::memory_order_relaxed);
+			s_Data.LiveBytes.fetch_add((int64_t)size, std::memory_order_relaxed);
+
+#if ENABLE_PROFILING
+			TracyAllocS(memory, size, MemoryCallstackDepth);
+#endif
+		}
+
+		return memory;
+	}
+
+	static void Free(void* memory)
+	{
+		if (!memory)
+			return;
+
+		const AllocationHeader* header = (const AllocationHeader*)memory - 1;
+
+		if (header->Tracked)
+		{
+			ThreadSlot& slot = GetThreadSlot();
+			slot.Frees.fetch_add(1, std::memory_order_relaxed);
+			slot.BytesFreed.fetch_add(header->Size, std::memory_order_relaxed);
+
+			s_Data.FrameFrees.fetch_add(1, std::memory_order_relaxed);
+			s_Data.FrameBytesFreed.fetch_add(header->Size, std::memory_order_relaxed);
+			s_Data.LiveBytes.fetch_sub((int64_t)header->Size, std::memory_order_relaxed);
+
+#if ENABLE_PROFILING
+			TracyFreeS(memory, MemoryCallstackDepth);
+#endif
+		}
+
+		std::free((uint8_t*)memory - header->Offset);
+	}
+
+	static void* AllocateOrThrow(size_t size, size_t alignment)
+	{
+		void* memory = Allocate(size, alignment);
+		if (!memory)
+			throw std::bad_alloc();
+		return memory;
+	}
+
+#endif
+
+}
+
+#if ENABLE_MEMORY_TRACKING
+
+// The nothrow variants forward to these by default
+void* operator new(size_t size) { return Core::AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](size_t size) { return Core::AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(size_t size, std::align_val_t alignment) { return Core::AllocateOrThrow(size, (size_t)alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return Core::AllocateOrThrow(size, (size_t)alignment); }
+
+void operator delete(void* memory) noexcept { Core::Free(memory); }
+void operator delete[](void* memory) noexcept { Core::Free(memory); }
+void operator delete(void* memory, size_t) noexcept { Core::Free(memory); }
+void operator delete[](void* memory, size_t) noexcept { Core::Free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { Core::Free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { Core::Free(memory); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept { Core::Free(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept { Core::Free(memory); }
+
+#endif
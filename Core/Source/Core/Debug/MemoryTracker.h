@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+// Replaces the global operator new/delete to count every heap allocation and report it to
+// Tracy's memory profiler. Opt-in, generate with `premake5 --memory-tracking <action>`.
+#ifndef ENABLE_MEMORY_TRACKING
+#define ENABLE_MEMORY_TRACKING 0
+#endif
+
+namespace Core {
+
+	struct AllocationStats
+	{
+		uint64_t Allocations = 0;
+		uint64_t Frees = 0;
+		uint64_t BytesAllocated = 0;
+		uint64_t BytesFreed = 0;
+	};
+
+	struct ThreadAllocationStats
+	{
+		char Name[32] = {};
+		AllocationStats Total; // Since the thread's first tracked allocation
+	};
+
+	// Steady-state frames should allocate nothing, see ApplicationSpecification::FrameAllocationBudget
+	struct AllocationBudget
+	{
+		uint64_t MaxAllocations = 0; // Per frame, 0 = unlimited
+		uint64_t MaxBytes = 0;       // Per frame, 0 = unlimited
+		uint64_t WarmupFrames = 60;  // Loading and first-use allocations are expected early on
+		bool AssertOnExceeded = false; // Aborts after the report in every build, otherwise only logs
+	};
+
+	constexpr bool IsMemoryTrackingAvailable() { return ENABLE_MEMORY_TRACKING; }
+
+	// Allocations made before this (static initialization, before Tracy is up) are not tracked
+	void StartMemoryTracking();
+
+	// Returns the allocations made on any thread since the last call and starts a new frame
+	AllocationStats EndAllocationFrame();
+
+	// Labels the calling thread in GetThreadAllocationStats. Copied, truncated to 31 characters.
+	void SetAllocationThreadName(const char* name);
+
+	std::vector<ThreadAllocationStats> GetThreadAllocationStats();
+	uint64_t GetLiveAllocationBytes();
+
+}
@@ -8,6 +8,7 @@
 
 #if ENABLE_PROFILING
 #define PROFILE_MARK_FRAME			FrameMark;
+#define PROFILE_MARK_FRAME_NAMED(NAME)	FrameMarkNamed(NAME);
 // NOTE(Peter): Use PROFILE_FUNC ONLY at the top of a function
 //				Use PROFILE_SCOPE / PROFILE_SCOPE_DYNAMIC for an inner scope
 #define PROFILE_FUNC(...)			ZoneScoped##__VA_OPT__(N(__VA_ARGS__))
@@ -16,6 +17,7 @@
 #define PROFILE_THREAD(...)          tracy::SetThreadName(__VA_ARGS__)
 #else
 #define PROFILE_MARK_FRAME
+#define PROFILE_MARK_FRAME_NAMED(NAME)
 #define PROFILE_FUNC(...)
 #define PROFILE_SCOPE(...)
 #define PROFILE_SCOPE_DYNAMIC(NAME)
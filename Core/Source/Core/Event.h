@@ -1,7 +1,7 @@
 #pragma once
 
 #include <string>
-#include <functional>
+#include <type_traits>
 
 namespace Core {
 
@@ -13,11 +13,24 @@ namespace Core {
 		MouseButtonPressed, MouseButtonReleased, MouseMoved, MouseScrolled,
 	};
 
+	enum EventCategory
+	{
+		EventCategoryNone        = 0,
+		EventCategoryApplication = 1 << 0,
+		EventCategoryInput       = 1 << 1,
+		EventCategoryKeyboard    = 1 << 2,
+		EventCategoryMouse       = 1 << 3,
+		EventCategoryMouseButton = 1 << 4,
+		EventCategoryAll         = ~0
+	};
 
 #define EVENT_CLASS_TYPE(type) static EventType GetStaticType() { return EventType::type; }\
 								virtual EventType GetEventType() const override { return GetStaticType(); }\
 								virtual const char* GetName() const override { return #type; }
 
+#define EVENT_CLASS_CATEGORY(category) static int GetStaticCategoryFlags() { return category; }\
+								virtual int GetCategoryFlags() const override { return GetStaticCategoryFlags(); }
+
 	class Event
 	{
 	public:
@@ -26,24 +39,27 @@ namespace Core {
 		virtual ~Event() {}
 		virtual EventType GetEventType() const = 0;
 		virtual const char* GetName() const = 0;
+		virtual int GetCategoryFlags() const = 0;
 		virtual std::string ToString() const { return GetName(); }
+
+		bool IsInCategory(EventCategory category) const { return GetCategoryFlags() & category; }
 	};
 
 	class EventDispatcher
 	{
-		template<typename T>
-		using EventFn = std::function<bool(T&)>;
 	public:
 		EventDispatcher(Event& event)
 			: m_Event(event) {
 		}
 
-		template<typename T>
-		bool Dispatch(EventFn<T> func)
+		// func is called directly with the event cast to T, so lambdas are never copied or type-erased
+		template<typename T, typename FuncT>
+			requires(std::is_invocable_r_v<bool, FuncT, T&>)
+		bool Dispatch(FuncT&& func)
 		{
 			if (m_Event.GetEventType() == T::GetStaticType() && !m_Event.Handled)
 			{
-				m_Event.Handled = func(*(T*)&m_Event);
+				m_Event.Handled = func(static_cast<T&>(m_Event));
 				return true;
 			}
 			return false;
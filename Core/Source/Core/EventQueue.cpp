@@ -0,0 +1,93 @@
+#include "EventQueue.h"
+
+#include "FrameAllocator.h"
+#include "InputEvents.h"
+#include "WindowEvents.h"
+
+#include "Debug/Profiler.h"
+
+#include <new>
+#include <type_traits>
+
+namespace Core {
+
+	EventQueue::~EventQueue()
+	{
+		Clear();
+	}
+
+	template<typename TEvent>
+	void EventQueue::Emplace(const TEvent& event)
+	{
+		void* storage = FrameAllocator::Allocate(sizeof(TEvent), alignof(TEvent));
+		m_Events.push_back(new (storage) TEvent(event));
+	}
+
+	template<typename TEvent>
+	bool EventQueue::Coalesce(const TEvent& event)
+	{
+		if (m_Events.size() <= m_DispatchIndex || m_Events.back()->GetEventType() != TEvent::GetStaticType())
+			return false;
+
+		// Same type, so the new event fits in the old one's storage
+		TEvent* last = (TEvent*)m_Events.back();
+		if constexpr (std::is_same_v<TEvent, MouseScrolledEvent>)
+		{
+			MouseScrolledEvent merged(last->GetXOffset() + event.GetXOffset(), last->GetYOffset() + event.GetYOffset());
+			last->~TEvent();
+			new (last) TEvent(merged);
+		}
+		else
+		{
+			last->~TEvent();
+			new (last) TEvent(event);
+		}
+
+		return true;
+	}
+
+	void EventQueue::Push(const Event& event)
+	{
+		PROFILE_FUNC();
+
+		m_RawEventCount++;
+
+		switch (event.GetEventType())
+		{
+		case EventType::WindowClose:         Emplace((const WindowClosedEvent&)event); break;
+		case EventType::WindowResize:        Emplace((const WindowResizeEvent&)event); break;
+		case EventType::KeyPressed:          Emplace((const KeyPressedEvent&)event); break;
+		case EventType::KeyReleased:         Emplace((const KeyReleasedEvent&)event); break;
+		case EventType::MouseButtonPressed:  Emplace((const MouseButtonPressedEvent&)event); break;
+		case EventType::MouseButtonReleased: Emplace((const MouseButtonReleasedEvent&)event); break;
+		case EventType::MouseMoved:
+		{
+			const MouseMovedEvent& mouseMoved = (const MouseMovedEvent&)event;
+			if (!Coalesce(mouseMoved))
+				Emplace(mouseMoved);
+			break;
+		}
+		case EventType::MouseScrolled:
+		{
+			const MouseScrolledEvent& mouseScrolled = (const MouseScrolledEvent&)event;
+			if (!Coalesce(mouseScrolled))
+				Emplace(mouseScrolled);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	void EventQueue::Clear()
+	{
+		// The memory goes back with the frame's arena
+		for (Event* event : m_Events)
+			event->~Event();
+
+		m_Events.clear();
+		m_DispatchIndex = 0;
+		m_RawEventCount = 0;
+	}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Event.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace Core {
+
+	struct EventQueueStats
+	{
+		uint32_t RawEvents = 0;        // Pushed by the window during the frame
+		uint32_t DispatchedEvents = 0; // Left after coalescing
+	};
+
+	// Collects a frame's window events so the layer stack is walked once per event per frame
+	// rather than once per OS callback. Events are copied into the FrameAllocator, they only
+	// have to live until the Dispatch of the frame they were pushed in. Consecutive MouseMoved events collapse into the latest one and consecutive
+	// MouseScrolled events sum their offsets; everything else keeps its place in the order.
+	class EventQueue
+	{
+	public:
+		EventQueue() = default;
+		~EventQueue();
+
+		EventQueue(const EventQueue&) = delete;
+		EventQueue& operator=(const EventQueue&) = delete;
+
+		void Push(const Event& event);
+
+		// Calls func on every queued event in order, then resets the queue. Events pushed
+		// from inside func are dispatched in the same pass.
+		template<typename FuncT>
+		void Dispatch(FuncT&& func)
+		{
+			while (m_DispatchIndex < m_Events.size())
+			{
+				Event* event = m_Events[m_DispatchIndex++];
+				func(*event);
+			}
+
+			m_LastFrameStats = { m_RawEventCount, (uint32_t)m_Events.size() };
+			Clear();
+		}
+
+		const EventQueueStats& GetLastFrameStats() const { return m_LastFrameStats; }
+	private:
+		template<typename TEvent>
+		void Emplace(const TEvent& event);
+		// Replaces the last queued event if it has the same type and hasn't been dispatched yet
+		template<typename TEvent>
+		bool Coalesce(const TEvent& event);
+
+		void Clear();
+	private:
+		std::vector<Event*> m_Events;
+		size_t m_DispatchIndex = 0; // First event not handed to Dispatch's func yet
+		uint32_t m_RawEventCount = 0;
+		EventQueueStats m_LastFrameStats;
+	};
+
+}
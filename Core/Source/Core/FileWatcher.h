@@ -0,0 +1,22 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace Core {
+
+	// Watches a directory tree for files that were written, created or renamed into place.
+	// Implemented per platform under Core/Platform (inotify on Linux, ReadDirectoryChangesW on Windows).
+	class FileWatcher
+	{
+	public:
+		virtual ~FileWatcher() = default;
+
+		// Returns each changed file once, as an absolute path. Never blocks.
+		virtual std::vector<std::filesystem::path> PollChanges() = 0;
+
+		static std::unique_ptr<FileWatcher> Create(const std::filesystem::path& directory);
+	};
+
+}
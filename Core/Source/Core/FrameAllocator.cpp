@@ -0,0 +1,182 @@
+#include "FrameAllocator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <print>
+
+namespace Core {
+
+	static constexpr uint32_t FramesInFlight = 2;
+	// Recycled memory is filled with this in debug builds, reads of stale frame data stand out
+	static constexpr uint8_t PoisonByte = 0xCD;
+
+	struct OverflowBlock
+	{
+		void* Memory;
+		size_t Alignment;
+	};
+
+	struct Arena
+	{
+		uint8_t* Memory = nullptr;
+		size_t Capacity = 0;
+		size_t Used = 0;
+		uint64_t Frame = ~0ull;
+		// Everything asked for this frame including alignment padding and overflow, read by GetStats
+		std::atomic<uint64_t> Requested = 0;
+		std::vector<OverflowBlock> Overflow;
+	};
+
+	struct ThreadArenas
+	{
+		Arena Arenas[FramesInFlight];
+
+		ThreadArenas();
+		~ThreadArenas();
+	};
+
+	struct FrameAllocatorData
+	{
+		std::atomic<uint64_t> Frame = 0;
+		std::atomic<size_t> ArenaSize = 0;
+
+		std::atomic<uint64_t> HighWaterMark = 0;
+		std::atomic<uint64_t> OverflowAllocations = 0;
+
+		std::mutex ThreadsMutex;
+		std::vector<ThreadArenas*> Threads;
+	};
+
+	static FrameAllocatorData s_Data;
+	static thread_local ThreadArenas t_Arenas;
+
+	static void UpdateHighWaterMark(uint64_t bytes)
+	{
+		uint64_t current = s_Data.HighWaterMark.load(std::memory_order_relaxed);
+		while (bytes > current && !s_Data.HighWaterMark.compare_exchange_weak(current, bytes, std::memory_order_relaxed))
+			;
+	}
+
+	static void ReleaseOverflow(Arena& arena)
+	{
+		for (const OverflowBlock& block : arena.Overflow)
+			::operator delete(block.Memory, std::align_val_t(block.Alignment));
+		arena.Overflow.clear();
+	}
+
+	static void ResetArena(Arena& arena, uint64_t frame)
+	{
+		UpdateHighWaterMark(arena.Requested.load(std::memory_order_relaxed));
+
+#if defined(DEBUG)
+		if (arena.Memory)
+			std::memset(arena.Memory, PoisonByte, arena.Used);
+#endif
+
+		ReleaseOverflow(arena);
+		arena.Used = 0;
+		arena.Requested.store(0, std::memory_order_relaxed);
+		arena.Frame = frame;
+	}
+
+	ThreadArenas::ThreadArenas()
+	{
+		std::scoped_lock lock(s_Data.ThreadsMutex);
+		s_Data.Threads.push_back(this);
+	}
+
+	ThreadArenas::~ThreadArenas()
+	{
+		{
+			std::scoped_lock lock(s_Data.ThreadsMutex);
+			std::erase(s_Data.Threads, this);
+		}
+
+		for (Arena& arena : Arenas)
+		{
+			UpdateHighWaterMark(arena.Requested.load(std::memory_order_relaxed));
+			ReleaseOverflow(arena);
+			std::free(arena.Memory);
+		}
+	}
+
+	void FrameAllocator::Init(size_t arenaSize)
+	{
+		s_Data.ArenaSize.store(arenaSize, std::memory_order_relaxed);
+	}
+
+	void FrameAllocator::Shutdown()
+	{
+		FrameAllocatorStats stats = GetStats();
+		std::println("[Frame Allocator] High-water mark {} of {} bytes per arena, {} overflow allocations",
+			stats.HighWaterMark, s_Data.ArenaSize.load(std::memory_order_relaxed), stats.OverflowAllocations);
+	}
+
+	void* FrameAllocator::Allocate(size_t size, size_t alignment)
+	{
+		const uint64_t frame = s_Data.Frame.load(std::memory_order_acquire);
+
+		Arena& arena = t_Arenas.Arenas[frame % FramesInFlight];
+		if (arena.Frame != frame)
+			ResetArena(arena, frame);
+
+		if (!arena.Memory)
+		{
+			arena.Capacity = s_Data.ArenaSize.load(std::memory_order_relaxed);
+			if (arena.Capacity > 0)
+				arena.Memory = (uint8_t*)std::malloc(arena.Capacity);
+		}
+
+		if (arena.Memory)
+		{
+			const uintptr_t base = (uintptr_t)arena.Memory;
+			const uintptr_t start = (base + arena.Used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+			const size_t end = (start - base) + size;
+
+			if (end <= arena.Capacity)
+			{
+				arena.Requested.fetch_add(end - arena.Used, std::memory_order_relaxed);
+				arena.Used = end;
+				return (void*)start;
+			}
+		}
+
+		// Out of arena, still correct but no longer free. Logged once, the high-water mark says how much is missing.
+		if (s_Data.OverflowAllocations.fetch_add(1, std::memory_order_relaxed) == 0)
+			std::cerr << "[Frame Allocator] Arena of " << arena.Capacity << " bytes exhausted, falling back to the heap" << std::endl;
+
+		void* memory = ::operator new(size, std::align_val_t(alignment));
+		arena.Overflow.push_back({ memory, alignment });
+		arena.Requested.fetch_add(size, std::memory_order_relaxed);
+		return memory;
+	}
+
+	void FrameAllocator::NextFrame()
+	{
+		s_Data.Frame.fetch_add(1, std::memory_order_release);
+	}
+
+	FrameAllocatorStats FrameAllocator::GetStats()
+	{
+		FrameAllocatorStats stats;
+		stats.ArenaCapacity = s_Data.ArenaSize.load(std::memory_order_relaxed);
+		stats.HighWaterMark = s_Data.HighWaterMark.load(std::memory_order_relaxed);
+		stats.OverflowAllocations = s_Data.OverflowAllocations.load(std::memory_order_relaxed);
+
+		// Frames that haven't been recycled yet count too
+		std::scoped_lock lock(s_Data.ThreadsMutex);
+		stats.ArenaCount = (uint32_t)s_Data.Threads.size() * FramesInFlight;
+		for (const ThreadArenas* thread : s_Data.Threads)
+		{
+			for (const Arena& arena : thread->Arenas)
+				stats.HighWaterMark = std::max(stats.HighWaterMark, arena.Requested.load(std::memory_order_relaxed));
+		}
+
+		return stats;
+	}
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Core {
+
+	struct FrameAllocatorStats
+	{
+		uint32_t ArenaCount = 0;       // Two per thread that has allocated
+		uint64_t ArenaCapacity = 0;    // Per arena
+		uint64_t HighWaterMark = 0;    // Most bytes any arena needed in a single frame, overflow included
+		uint64_t OverflowAllocations = 0; // Allocations that didn't fit and went to the heap
+	};
+
+	// Bump allocator for data that only has to live until the end of the next frame.
+	// Every thread allocates from its own arena, so there is no locking. Arenas are
+	// double-buffered: memory from frame N stays valid while the render thread executes
+	// frame N, and is recycled once frame N + 2 starts. Destructors are never run.
+	class FrameAllocator
+	{
+	public:
+		// arenaSize bytes are reserved per arena, lazily, by each thread's first allocation
+		static void Init(size_t arenaSize);
+		static void Shutdown();
+
+		static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		template<typename T, typename... Args>
+			requires(std::is_trivially_destructible_v<T>)
+		static T* New(Args&&... args)
+		{
+			return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		template<typename T>
+			requires(std::is_trivially_destructible_v<T>)
+		static T* NewArray(size_t count)
+		{
+			return new (Allocate(sizeof(T) * count, alignof(T))) T[count];
+		}
+
+		// Called by Application at the frame boundary. Arenas reset themselves on their next allocation.
+		static void NextFrame();
+
+		static FrameAllocatorStats GetStats();
+	};
+
+	// STL allocator adapter, deallocation is a no-op
+	template<typename T>
+	class FrameStlAllocator
+	{
+	public:
+		using value_type = T;
+
+		FrameStlAllocator() = default;
+		template<typename U>
+		FrameStlAllocator(const FrameStlAllocator<U>&) noexcept {}
+
+		T* allocate(size_t count) { return (T*)FrameAllocator::Allocate(sizeof(T) * count, alignof(T)); }
+		void deallocate(T*, size_t) noexcept {}
+
+		template<typename U>
+		bool operator==(const FrameStlAllocator<U>&) const noexcept { return true; }
+	};
+
+	template<typename T>
+	using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+	using FrameString = std::basic_string<char, std::char_traits<char>, FrameStlAllocator<char>>;
+
+}
@@ -0,0 +1,61 @@
+#include "FramePacer.h"
+
+#include "Application.h"
+
+#include "Debug/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace Core {
+
+	static constexpr uint64_t SleepStepNs = 1'000'000;
+
+	void FramePacer::SetTargetFrameRate(uint32_t framesPerSecond)
+	{
+		m_FrameDurationNs = framesPerSecond > 0 ? 1'000'000'000ull / framesPerSecond : 0;
+		m_NextFrameNs = 0;
+	}
+
+	void FramePacer::Wait()
+	{
+		if (m_FrameDurationNs == 0)
+			return;
+
+		PROFILE_FUNC();
+
+		const uint64_t start = Application::GetTime();
+
+		// First frame, or more than a frame late
+		if (m_NextFrameNs == 0 || start > m_NextFrameNs + m_FrameDurationNs)
+		{
+			m_NextFrameNs = start + m_FrameDurationNs;
+			m_LastWaitNs = 0;
+			return;
+		}
+
+		uint64_t now = start;
+		while (now < m_NextFrameNs && m_NextFrameNs - now > m_SleepErrorNs + SleepStepNs)
+		{
+			std::this_thread::sleep_for(std::chrono::nanoseconds(SleepStepNs));
+
+			const uint64_t woke = Application::GetTime();
+			const uint64_t oversleep = woke - now > SleepStepNs ? woke - now - SleepStepNs : 0;
+
+			// Track the worst case, decaying slowly so one hiccup doesn't spin forever
+			m_SleepErrorNs = std::max(oversleep, m_SleepErrorNs - m_SleepErrorNs / 64);
+			now = woke;
+		}
+
+		while (now < m_NextFrameNs)
+		{
+			std::this_thread::yield();
+			now = Application::GetTime();
+		}
+
+		m_LastWaitNs = now - start;
+		m_NextFrameNs += m_FrameDurationNs;
+	}
+
+}
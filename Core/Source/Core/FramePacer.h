@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace Core {
+
+	// Caps the frame rate without burning a core: sleeps for the bulk of the wait and
+	// spins for the last stretch, sized from how much the OS has been oversleeping.
+	class FramePacer
+	{
+	public:
+		// 0 disables pacing
+		void SetTargetFrameRate(uint32_t framesPerSecond);
+
+		// Blocks until the next frame is due. Frames that run late start the schedule over
+		// rather than rushing to catch up.
+		void Wait();
+
+		uint64_t GetLastWaitNs() const { return m_LastWaitNs; }
+	private:
+		uint64_t m_FrameDurationNs = 0;
+		uint64_t m_NextFrameNs = 0;
+		uint64_t m_SleepErrorNs = 1'000'000; // Worst recent oversleep, starts pessimistic
+		uint64_t m_LastWaitNs = 0;
+	};
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+#include <string_view>
+
+namespace Core::Hash {
+
+	// 64-bit FNV-1a. Stable across runs and platforms, so it's safe to persist.
+	constexpr uint64_t FNVOffsetBasis = 14695981039346656037ull;
+	constexpr uint64_t FNVPrime = 1099511628211ull;
+
+	constexpr uint64_t FNV1a(std::string_view data, uint64_t hash = FNVOffsetBasis)
+	{
+		for (char c : data)
+		{
+			hash ^= (uint8_t)c;
+			hash *= FNVPrime;
+		}
+		return hash;
+	}
+
+	constexpr uint64_t Combine(uint64_t seed, uint64_t value)
+	{
+		return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+	}
+
+}
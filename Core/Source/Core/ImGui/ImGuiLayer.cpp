@@ -2,7 +2,9 @@
 
 #include "Core/Application.h"
 
+#include "Core/Debug/GPUProfiler.h"
 #include "Core/Debug/Profiler.h"
+#include "Core/Renderer/RenderCommandQueue.h"
 
 #include "Colors.h"
 
@@ -18,10 +20,30 @@
 
 namespace Core {
 
+	// Deep copy of ImGui's draw data, which is only valid until the next ImGui::NewFrame
+	struct DrawDataSnapshot
+	{
+		ImDrawData DrawData;
+
+		DrawDataSnapshot(const ImDrawData* source)
+			: DrawData(*source)
+		{
+			for (ImDrawList*& drawList : DrawData.CmdLists)
+				drawList = drawList->CloneOutput();
+		}
+
+		~DrawDataSnapshot()
+		{
+			for (ImDrawList* drawList : DrawData.CmdLists)
+				IM_DELETE(drawList);
+		}
+	};
+
 	ImGuiLayer::ImGuiLayer()
 		: Layer("ImGuiLayer")
 	{
-
+		// OnEvent does nothing, the ImGui GLFW backend gets input through its own callbacks
+		SetEventCategories(EventCategoryNone);
 	}
 
 	void ImGuiLayer::OnAttach()
@@ -37,6 +59,13 @@ namespace Core {
 		io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;           // Enable Docking
 		io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;         // Enable Multi-Viewport / Platform Windows
 
+		Application& app = Application::Get();
+
+		// Platform windows create and swap their own contexts on the main thread, and
+		// there is nothing to show them on when headless
+		if (app.GetSpecification().UseRenderThread || app.GetSpecification().Headless)
+			io.ConfigFlags &= ~ImGuiConfigFlags_ViewportsEnable;
+
 		float fontSize = 18.0f;// *2.0f;
 
 		io.Fonts->AddFontFromFileTTF("Resources/Fonts/opensans/OpenSans-Bold.ttf", fontSize);
@@ -55,12 +84,15 @@ namespace Core {
 		}
 		style.Colors[ImGuiCol_WindowBg] = ImVec4(0.15f, 0.15f, 0.15f, style.Colors[ImGuiCol_WindowBg].w);
 
-		Application& app = Application::Get();
 		GLFWwindow* window = static_cast<GLFWwindow*>(app.GetWindow()->GetHandle());
 
 		// Setup Platform/Renderer bindings
 		ImGui_ImplGlfw_InitForOpenGL(window, true);
 		ImGui_ImplOpenGL3_Init("#version 460");
+
+		// Create GL objects (including the font atlas) while the main thread still owns the context,
+		// so ImGui_ImplOpenGL3_NewFrame never has to touch GL from the main thread later on
+		ImGui_ImplOpenGL3_CreateDeviceObjects();
 	}
 
 	void ImGuiLayer::OnDetach()
@@ -100,14 +132,39 @@ namespace Core {
 
 		// Rendering
 		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+		if (app.GetSpecification().UseRenderThread)
+		{
+			// The render thread draws this while the next frame is already being built
+			auto snapshot = std::make_unique<DrawDataSnapshot>(ImGui::GetDrawData());
+			Renderer::Submit([snapshot = std::move(snapshot)]()
+			{
+				PROFILE_GPU_SCOPE("ImGui");
+				ImGui_ImplOpenGL3_RenderDrawData(&snapshot->DrawData);
+			});
+		}
+		else
+		{
+			Renderer::Submit([]()
+			{
+				PROFILE_GPU_SCOPE("ImGui");
+				ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+			});
+		}
 
 		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
 		{
 			GLFWwindow* backup_current_context = glfwGetCurrentContext();
 			ImGui::UpdatePlatformWindows();
-			ImGui::RenderPlatformWindowsDefault();
 			glfwMakeContextCurrent(backup_current_context);
+
+			Renderer::Submit([]()
+			{
+				PROFILE_GPU_SCOPE("ImGui Viewports");
+				GLFWwindow* backup_current_context = glfwGetCurrentContext();
+				ImGui::RenderPlatformWindowsDefault();
+				glfwMakeContextCurrent(backup_current_context);
+			});
 		}
 	}
 
@@ -35,6 +35,7 @@ namespace Core {
 		}
 
 		EVENT_CLASS_TYPE(KeyPressed)
+		EVENT_CLASS_CATEGORY(EventCategoryKeyboard | EventCategoryInput)
 	private:
 		bool m_IsRepeat;
 	};
@@ -51,6 +52,7 @@ namespace Core {
 		}
 
 		EVENT_CLASS_TYPE(KeyReleased)
+		EVENT_CLASS_CATEGORY(EventCategoryKeyboard | EventCategoryInput)
 	};
 
 	//
@@ -72,6 +74,7 @@ namespace Core {
 		}
 
 		EVENT_CLASS_TYPE(MouseMoved)
+		EVENT_CLASS_CATEGORY(EventCategoryMouse | EventCategoryInput)
 	private:
 		double m_MouseX, m_MouseY;
 	};
@@ -91,6 +94,7 @@ namespace Core {
 		}
 
 		EVENT_CLASS_TYPE(MouseScrolled)
+		EVENT_CLASS_CATEGORY(EventCategoryMouse | EventCategoryInput)
 	private:
 		double m_XOffset, m_YOffset;
 	};
@@ -118,6 +122,7 @@ namespace Core {
 		}
 
 		EVENT_CLASS_TYPE(MouseButtonPressed)
+		EVENT_CLASS_CATEGORY(EventCategoryMouse | EventCategoryMouseButton | EventCategoryInput)
 	};
 
 	class MouseButtonReleasedEvent : public MouseButtonEvent
@@ -132,6 +137,7 @@ namespace Core {
 		}
 
 		EVENT_CLASS_TYPE(MouseButtonReleased)
+		EVENT_CLASS_CATEGORY(EventCategoryMouse | EventCategoryMouseButton | EventCategoryInput)
 	};
 
 	
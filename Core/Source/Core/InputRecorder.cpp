@@ -0,0 +1,233 @@
+#include "InputRecorder.h"
+
+#include "InputEvents.h"
+#include "WindowEvents.h"
+
+#include "Debug/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <print>
+
+namespace Core {
+
+	static constexpr uint32_t RecordingMagic = 0x43455243; // 'CREC'
+	static constexpr uint32_t RecordingVersion = 1;
+
+	// Followed by EventCount records of: uint32 frame, uint64 timestamp, uint8 type, type-specific payload
+	struct RecordingHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint64_t FrameCount;
+		uint64_t EventCount;
+	};
+
+	static uint64_t GetTimestampNs()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	template<typename T>
+	static void Write(std::ofstream& file, const T& value)
+	{
+		file.write((const char*)&value, sizeof(T));
+	}
+
+	template<typename T>
+	static bool Read(std::ifstream& file, T& value)
+	{
+		return (bool)file.read((char*)&value, sizeof(T));
+	}
+
+	InputRecorder::~InputRecorder()
+	{
+		if (IsRecording())
+			EndRecording(m_RecordedFrameCount);
+	}
+
+	bool InputRecorder::BeginRecording(const std::filesystem::path& path)
+	{
+		std::error_code error;
+		if (path.has_parent_path())
+			std::filesystem::create_directories(path.parent_path(), error);
+
+		m_File.open(path, std::ios::binary | std::ios::trunc);
+		if (!m_File.is_open())
+		{
+			std::cerr << "Failed to open input recording: " << path.string() << std::endl;
+			return false;
+		}
+
+		// Counts are patched in by EndRecording
+		Write(m_File, RecordingHeader{ RecordingMagic, RecordingVersion, 0, 0 });
+
+		m_RecordStartNs = GetTimestampNs();
+		m_RecordedFrameCount = 0;
+		m_RecordedEventCount = 0;
+		return true;
+	}
+
+	void InputRecorder::Record(uint64_t frameIndex, const Event& event)
+	{
+		if (!IsRecording())
+			return;
+
+		Write(m_File, (uint32_t)frameIndex);
+		Write(m_File, GetTimestampNs() - m_RecordStartNs);
+		Write(m_File, (uint8_t)event.GetEventType());
+
+		switch (event.GetEventType())
+		{
+		case EventType::WindowClose:
+			break;
+		case EventType::WindowResize:
+		{
+			const WindowResizeEvent& resize = (const WindowResizeEvent&)event;
+			Write(m_File, resize.GetWidth());
+			Write(m_File, resize.GetHeight());
+			break;
+		}
+		case EventType::KeyPressed:
+		{
+			const KeyPressedEvent& key = (const KeyPressedEvent&)event;
+			Write(m_File, (int32_t)key.GetKeyCode());
+			Write(m_File, (uint8_t)key.IsRepeat());
+			break;
+		}
+		case EventType::KeyReleased:
+			Write(m_File, (int32_t)((const KeyReleasedEvent&)event).GetKeyCode());
+			break;
+		case EventType::MouseButtonPressed:
+		case EventType::MouseButtonReleased:
+			Write(m_File, (int32_t)((const MouseButtonEvent&)event).GetMouseButton());
+			break;
+		case EventType::MouseMoved:
+		{
+			const MouseMovedEvent& mouseMoved = (const MouseMovedEvent&)event;
+			Write(m_File, mouseMoved.GetX());
+			Write(m_File, mouseMoved.GetY());
+			break;
+		}
+		case EventType::MouseScrolled:
+		{
+			const MouseScrolledEvent& mouseScrolled = (const MouseScrolledEvent&)event;
+			Write(m_File, mouseScrolled.GetXOffset());
+			Write(m_File, mouseScrolled.GetYOffset());
+			break;
+		}
+		default:
+			break;
+		}
+
+		m_RecordedFrameCount = frameIndex + 1;
+		m_RecordedEventCount++;
+	}
+
+	void InputRecorder::EndRecording(uint64_t frameCount)
+	{
+		if (!IsRecording())
+			return;
+
+		m_File.seekp(0);
+		Write(m_File, RecordingHeader{ RecordingMagic, RecordingVersion, std::max(frameCount, m_RecordedFrameCount), m_RecordedEventCount });
+		m_File.close();
+
+		std::println("[Input Recorder] Recorded {} events over {} frames", m_RecordedEventCount, std::max(frameCount, m_RecordedFrameCount));
+	}
+
+	bool InputRecorder::LoadReplay(const std::filesystem::path& path)
+	{
+		PROFILE_FUNC();
+
+		std::ifstream file(path, std::ios::binary);
+
+		RecordingHeader header{};
+		if (!file.is_open() || !Read(file, header) || header.Magic != RecordingMagic || header.Version != RecordingVersion)
+		{
+			std::cerr << "Failed to load input recording: " << path.string() << std::endl;
+			return false;
+		}
+
+		m_ReplayEvents.clear();
+		m_ReplayEvents.reserve(header.EventCount);
+
+		for (uint64_t i = 0; i < header.EventCount; i++)
+		{
+			RecordedEvent event{};
+			uint8_t type = 0;
+			bool valid = Read(file, event.Frame) && Read(file, event.TimestampNs) && Read(file, type);
+			event.Type = (EventType)type;
+
+			switch (event.Type)
+			{
+			case EventType::WindowClose:
+				break;
+			case EventType::WindowResize:
+				valid = valid && Read(file, event.Resize.Width) && Read(file, event.Resize.Height);
+				break;
+			case EventType::KeyPressed:
+			{
+				uint8_t isRepeat = 0;
+				valid = valid && Read(file, event.Key.Code) && Read(file, isRepeat);
+				event.Key.IsRepeat = isRepeat != 0;
+				break;
+			}
+			case EventType::KeyReleased:
+				valid = valid && Read(file, event.Key.Code);
+				break;
+			case EventType::MouseButtonPressed:
+			case EventType::MouseButtonReleased:
+				valid = valid && Read(file, event.MouseButton.Button);
+				break;
+			case EventType::MouseMoved:
+			case EventType::MouseScrolled:
+				valid = valid && Read(file, event.Mouse.X) && Read(file, event.Mouse.Y);
+				break;
+			default:
+				valid = false;
+				break;
+			}
+
+			if (!valid)
+			{
+				std::cerr << "Input recording is truncated or corrupt: " << path.string() << std::endl;
+				return false;
+			}
+
+			m_ReplayEvents.push_back(event);
+		}
+
+		m_ReplayCursor = 0;
+		m_ReplayFrameCount = header.FrameCount;
+		m_Replaying = true;
+		return true;
+	}
+
+	void InputRecorder::ReplayFrame(uint64_t frameIndex, EventQueue& queue)
+	{
+		if (!m_Replaying)
+			return;
+
+		while (m_ReplayCursor < m_ReplayEvents.size() && m_ReplayEvents[m_ReplayCursor].Frame <= frameIndex)
+		{
+			const RecordedEvent& event = m_ReplayEvents[m_ReplayCursor++];
+
+			switch (event.Type)
+			{
+			case EventType::WindowClose:         queue.Push(WindowClosedEvent()); break;
+			case EventType::WindowResize:        queue.Push(WindowResizeEvent(event.Resize.Width, event.Resize.Height)); break;
+			case EventType::KeyPressed:          queue.Push(KeyPressedEvent(event.Key.Code, event.Key.IsRepeat)); break;
+			case EventType::KeyReleased:         queue.Push(KeyReleasedEvent(event.Key.Code)); break;
+			case EventType::MouseButtonPressed:  queue.Push(MouseButtonPressedEvent(event.MouseButton.Button)); break;
+			case EventType::MouseButtonReleased: queue.Push(MouseButtonReleasedEvent(event.MouseButton.Button)); break;
+			case EventType::MouseMoved:          queue.Push(MouseMovedEvent(event.Mouse.X, event.Mouse.Y)); break;
+			case EventType::MouseScrolled:       queue.Push(MouseScrolledEvent(event.Mouse.X, event.Mouse.Y)); break;
+			default:
+				break;
+			}
+		}
+	}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Event.h"
+#include "EventQueue.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdint.h>
+#include <vector>
+
+namespace Core {
+
+	// Records the raw window event stream to a compact binary file and plays it back on the
+	// same frame indices, so a scenario can be re-run identically for performance captures.
+	// Only events are captured: state polled directly from GLFW (glfwGetKey, cursor position
+	// queries) during a replay still comes from the live window.
+	class InputRecorder
+	{
+	public:
+		InputRecorder() = default;
+		~InputRecorder();
+
+		bool BeginRecording(const std::filesystem::path& path);
+		void Record(uint64_t frameIndex, const Event& event);
+		// Writes the final frame count, called automatically on destruction
+		void EndRecording(uint64_t frameCount);
+
+		bool LoadReplay(const std::filesystem::path& path);
+		// Pushes every event recorded on frameIndex, in their original order
+		void ReplayFrame(uint64_t frameIndex, EventQueue& queue);
+
+		bool IsRecording() const { return m_File.is_open(); }
+		bool IsReplaying() const { return m_Replaying; }
+		// True once frameIndex is past the last recorded frame
+		bool IsReplayFinished(uint64_t frameIndex) const { return m_Replaying && frameIndex >= m_ReplayFrameCount; }
+	private:
+		struct RecordedEvent
+		{
+			uint32_t Frame;
+			uint64_t TimestampNs; // Since the recording started
+			EventType Type;
+			union
+			{
+				struct { int32_t Code; bool IsRepeat; } Key;
+				struct { int32_t Button; } MouseButton;
+				struct { double X, Y; } Mouse; // Position, or scroll offsets
+				struct { uint32_t Width, Height; } Resize;
+			};
+		};
+	private:
+		std::ofstream m_File;
+		uint64_t m_RecordStartNs = 0;
+		uint64_t m_RecordedFrameCount = 0;
+		uint64_t m_RecordedEventCount = 0;
+
+		std::vector<RecordedEvent> m_ReplayEvents;
+		size_t m_ReplayCursor = 0;
+		uint64_t m_ReplayFrameCount = 0;
+		bool m_Replaying = false;
+	};
+
+}
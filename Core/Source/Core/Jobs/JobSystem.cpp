@@ -0,0 +1,261 @@
+#include "JobSystem.h"
+
+#include "Core/Debug/MemoryTracker.h"
+#include "Core/Debug/Profiler.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <condition_variable>
+#include <deque>
+#include <format>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Core {
+
+	struct Job
+	{
+		JobSystem::JobFn Function;
+		std::shared_ptr<JobCounter> Counter;
+	};
+
+	class WorkQueue
+	{
+	public:
+		void Push(Job&& job)
+		{
+			std::scoped_lock lock(m_Mutex);
+			m_Jobs.push_back(std::move(job));
+		}
+
+		// Owner side, newest first so the data it just touched is still in cache
+		bool Pop(Job& job)
+		{
+			std::scoped_lock lock(m_Mutex);
+			if (m_Jobs.empty())
+				return false;
+
+			job = std::move(m_Jobs.back());
+			m_Jobs.pop_back();
+			return true;
+		}
+
+		// Thief side, oldest first
+		bool Steal(Job& job)
+		{
+			std::scoped_lock lock(m_Mutex);
+			if (m_Jobs.empty())
+				return false;
+
+			job = std::move(m_Jobs.front());
+			m_Jobs.pop_front();
+			return true;
+		}
+	private:
+		std::mutex m_Mutex;
+		std::deque<Job> m_Jobs;
+	};
+
+	struct JobSystemData
+	{
+		// Queue 0 belongs to the thread that called Init, the rest to workers
+		std::vector<std::unique_ptr<WorkQueue>> Queues;
+		std::vector<std::thread> Workers;
+
+		std::atomic<bool> Running = false;
+		std::atomic<uint32_t> PendingJobs = 0;
+		std::atomic<uint32_t> NextQueue = 0;
+
+		std::mutex SleepMutex;
+		std::condition_variable WakeCondition;
+	};
+
+	static JobSystemData* s_Data = nullptr;
+	static thread_local int32_t s_QueueIndex = -1;
+
+	static bool TryRunJob(int32_t queueIndex)
+	{
+		Job job;
+		bool found = queueIndex >= 0 && s_Data->Queues[queueIndex]->Pop(job);
+
+		if (!found)
+		{
+			const uint32_t queueCount = (uint32_t)s_Data->Queues.size();
+			const uint32_t start = queueIndex >= 0 ? (uint32_t)queueIndex + 1 : 0;
+			for (uint32_t i = 0; i < queueCount && !found; i++)
+			{
+				uint32_t victim = (start + i) % queueCount;
+				if ((int32_t)victim != queueIndex)
+					found = s_Data->Queues[victim]->Steal(job);
+			}
+		}
+
+		if (!found)
+			return false;
+
+		s_Data->PendingJobs.fetch_sub(1, std::memory_order_relaxed);
+
+		job.Function();
+		job.Counter->Value.fetch_sub(1, std::memory_order_release);
+		return true;
+	}
+
+	static void WorkerThread(uint32_t queueIndex)
+	{
+		s_QueueIndex = (int32_t)queueIndex;
+
+		std::string threadName = std::format("Job Worker {}", queueIndex);
+		PROFILE_THREAD(threadName.c_str());
+		SetAllocationThreadName(threadName.c_str());
+
+		while (s_Data->Running.load(std::memory_order_acquire))
+		{
+			if (TryRunJob(s_QueueIndex))
+				continue;
+
+			std::unique_lock lock(s_Data->SleepMutex);
+			s_Data->WakeCondition.wait(lock, []
+			{
+				return s_Data->PendingJobs.load(std::memory_order_relaxed) > 0 || !s_Data->Running.load(std::memory_order_relaxed);
+			});
+		}
+	}
+
+	static void PushJob(Job&& job)
+	{
+		// Threads without their own queue (e.g. the render thread) spread work round-robin
+		uint32_t queueIndex = s_QueueIndex >= 0 ? (uint32_t)s_QueueIndex
+			: s_Data->NextQueue.fetch_add(1, std::memory_order_relaxed) % (uint32_t)s_Data->Queues.size();
+
+		s_Data->PendingJobs.fetch_add(1, std::memory_order_relaxed);
+		s_Data->Queues[queueIndex]->Push(std::move(job));
+
+		// Taking the lock orders this with a worker that is about to go to sleep
+		{
+			std::scoped_lock lock(s_Data->SleepMutex);
+		}
+		s_Data->WakeCondition.notify_one();
+	}
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		PROFILE_FUNC();
+
+		assert(!s_Data);
+
+		if (workerCount == 0)
+			workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		s_Data = new JobSystemData();
+		s_Data->Running = true;
+
+		for (uint32_t i = 0; i < workerCount + 1; i++)
+			s_Data->Queues.push_back(std::make_unique<WorkQueue>());
+
+		s_QueueIndex = 0;
+
+		for (uint32_t i = 1; i < workerCount + 1; i++)
+			s_Data->Workers.emplace_back(WorkerThread, i);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		PROFILE_FUNC();
+
+		if (!s_Data)
+			return;
+
+		// Finish anything still queued so outstanding handles complete
+		while (TryRunJob(s_QueueIndex))
+			;
+
+		{
+			std::scoped_lock lock(s_Data->SleepMutex);
+			s_Data->Running = false;
+		}
+		s_Data->WakeCondition.notify_all();
+
+		for (std::thread& worker : s_Data->Workers)
+			worker.join();
+
+		delete s_Data;
+		s_Data = nullptr;
+		s_QueueIndex = -1;
+	}
+
+	JobHandle JobSystem::Schedule(JobFn job)
+	{
+		JobHandle handle;
+		Schedule(handle, std::move(job));
+		return handle;
+	}
+
+	void JobSystem::Schedule(JobHandle& handle, JobFn job)
+	{
+		if (!handle.m_Counter)
+			handle.m_Counter = std::make_shared<JobCounter>();
+
+		// Nothing to hand the job to, run it right away
+		if (!s_Data)
+		{
+			job();
+			return;
+		}
+
+		handle.m_Counter->Value.fetch_add(1, std::memory_order_relaxed);
+		PushJob({ std::move(job), handle.m_Counter });
+	}
+
+	void JobSystem::Wait(const JobHandle& handle)
+	{
+		PROFILE_FUNC();
+
+		while (!handle.IsDone())
+		{
+			if (!TryRunJob(s_QueueIndex))
+				std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const ParallelForFn& func)
+	{
+		PROFILE_FUNC();
+
+		if (count == 0)
+			return;
+
+		batchSize = std::max(batchSize, 1u);
+		const uint32_t batchCount = (count + batchSize - 1) / batchSize;
+
+		if (batchCount == 1 || GetWorkerCount() == 0)
+		{
+			func(0, count);
+			return;
+		}
+
+		JobHandle handle;
+
+		// The calling thread takes the first batch itself instead of queueing it
+		for (uint32_t batch = 1; batch < batchCount; batch++)
+		{
+			uint32_t begin = batch * batchSize;
+			uint32_t end = std::min(begin + batchSize, count);
+			Schedule(handle, [&func, begin, end]() { func(begin, end); });
+		}
+
+		func(0, std::min(batchSize, count));
+		Wait(handle);
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return s_Data ? (uint32_t)s_Data->Workers.size() : 0;
+	}
+
+	bool JobSystem::IsInitialized()
+	{
+		return s_Data != nullptr;
+	}
+
+}
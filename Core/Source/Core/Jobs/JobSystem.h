@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stdint.h>
+
+namespace Core {
+
+	struct JobCounter
+	{
+		std::atomic<uint32_t> Value = 0;
+	};
+
+	// Tracks a group of scheduled jobs. The handle is done once every job
+	// scheduled against it has finished running.
+	class JobHandle
+	{
+	public:
+		JobHandle() = default;
+
+		bool IsValid() const { return m_Counter != nullptr; }
+		bool IsDone() const { return !m_Counter || m_Counter->Value.load(std::memory_order_acquire) == 0; }
+	private:
+		std::shared_ptr<JobCounter> m_Counter;
+
+		friend class JobSystem;
+	};
+
+	// Work-stealing job system. Every worker owns a deque it pushes to and pops
+	// from at the back; idle workers steal from the front of the others. The
+	// thread that calls Init gets a deque too and helps out while it waits.
+	class JobSystem
+	{
+	public:
+		using JobFn = std::function<void()>;
+		using ParallelForFn = std::function<void(uint32_t begin, uint32_t end)>;
+
+		// workerCount == 0 spawns one worker per hardware thread minus the calling thread
+		static void Init(uint32_t workerCount = 0);
+		static void Shutdown();
+
+		static JobHandle Schedule(JobFn job);
+		// Adds another job to an existing handle so a single Wait covers the group
+		static void Schedule(JobHandle& handle, JobFn job);
+
+		// Runs pending jobs on the calling thread until the handle is done
+		static void Wait(const JobHandle& handle);
+
+		// Splits [0, count) into batches of batchSize and blocks until all have run
+		static void ParallelFor(uint32_t count, uint32_t batchSize, const ParallelForFn& func);
+
+		static uint32_t GetWorkerCount();
+		// Workers plus the thread that owns the job system
+		static uint32_t GetThreadCount() { return GetWorkerCount() + 1; }
+
+		static bool IsInitialized();
+	};
+
+}
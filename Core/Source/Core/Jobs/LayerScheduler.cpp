@@ -0,0 +1,91 @@
+#include "LayerScheduler.h"
+
+#include "JobSystem.h"
+
+#include "Core/Debug/Profiler.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace Core {
+
+	static void RunParallelLayers(std::vector<Layer*>& layers, const std::function<void(Layer&)>& func)
+	{
+		if (layers.empty())
+			return;
+
+		if (layers.size() == 1)
+		{
+			func(*layers[0]);
+			return;
+		}
+
+		PROFILE_FUNC();
+
+		// Each layer goes one wave after the latest layer it depends on. Bounded by
+		// the layer count so a dependency cycle degrades to some order instead of hanging.
+		std::vector<uint32_t> waves(layers.size(), 0);
+		for (size_t pass = 0; pass < layers.size(); pass++)
+		{
+			bool changed = false;
+			for (size_t i = 0; i < layers.size(); i++)
+			{
+				for (size_t j = 0; j < layers.size(); j++)
+				{
+					if (i != j && waves[i] <= waves[j] && layers[i]->DependsOn(layers[j]))
+					{
+						waves[i] = waves[j] + 1;
+						changed = true;
+					}
+				}
+			}
+
+			if (!changed)
+				break;
+		}
+
+		const uint32_t waveCount = *std::max_element(waves.begin(), waves.end()) + 1;
+
+		std::vector<Layer*> wave;
+		for (uint32_t w = 0; w < waveCount; w++)
+		{
+			wave.clear();
+			for (size_t i = 0; i < layers.size(); i++)
+			{
+				if (waves[i] == w)
+					wave.push_back(layers[i]);
+			}
+
+			JobSystem::ParallelFor((uint32_t)wave.size(), 1, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; i++)
+				{
+					PROFILE_SCOPE_DYNAMIC(wave[i]->GetName().c_str());
+					func(*wave[i]);
+				}
+			});
+		}
+	}
+
+	void ScheduleLayerUpdates(std::span<const std::unique_ptr<Layer>> layers, const std::function<void(Layer&)>& func)
+	{
+		std::vector<Layer*> parallelLayers;
+
+		for (const std::unique_ptr<Layer>& layer : layers)
+		{
+			if (layer->IsParallelUpdate())
+			{
+				parallelLayers.push_back(layer.get());
+				continue;
+			}
+
+			RunParallelLayers(parallelLayers, func);
+			parallelLayers.clear();
+
+			func(*layer);
+		}
+
+		RunParallelLayers(parallelLayers, func);
+	}
+
+}
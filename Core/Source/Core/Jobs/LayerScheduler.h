@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Core/Layer.h"
+
+#include <functional>
+#include <memory>
+#include <span>
+
+namespace Core {
+
+	// Calls func on every layer in stack order. Runs of consecutive parallel layers
+	// are fanned out to the job system in dependency waves; a regular layer acts as
+	// a barrier and runs on the calling thread once everything before it is done.
+	void ScheduleLayerUpdates(std::span<const std::unique_ptr<Layer>> layers, const std::function<void(Layer&)>& func);
+
+}
@@ -10,18 +10,21 @@ namespace Core {
 
 	}
 
-	void Layer::QueueTransition(std::unique_ptr<Layer> toLayer)
+	bool Layer::DependsOn(const Layer* layer) const
 	{
-		// TODO: don't do this
-		auto& layerStack = Application::Get().m_LayerStack;
-		for (auto& layer : layerStack)
+		for (auto matches : m_UpdateDependencies)
 		{
-			if (layer.get() == this)
-			{
-				layer = std::move(toLayer);
-				return;
-			}
+			if (matches(layer))
+				return true;
 		}
+		return false;
+	}
+
+	void Layer::QueueTransition(std::unique_ptr<Layer> toLayer)
+	{
+		// Swapping the layer out here would destroy it while it may still be updating
+		// (possibly on a worker thread), so the application applies it before the next update pass
+		Application::Get().QueueLayerTransition(this, std::move(toLayer));
 	}
 
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Event.h"
 
 #include <memory>
+#include <vector>
 
 namespace Core {
 
@@ -17,6 +18,9 @@ namespace Core {
 		virtual void OnDetach() {}
 
 		virtual void OnUpdate(float ts) {}
+		// Called zero or more times per frame at ApplicationSpecification::FixedUpdateRate,
+		// before OnUpdate. Only runs when the update mode is UpdateMode::FixedTimestep.
+		virtual void OnFixedUpdate(float ts) {}
 		virtual void OnImGuiRender() {}
 		virtual void OnRender() {}
 
@@ -25,10 +29,38 @@ namespace Core {
 		{
 			QueueTransition(std::move(std::make_unique<T>(std::forward<Args>(args)...)));
 		}
+
+		// Layers update one after another on the main thread unless they opt in here.
+		// Only do so if OnUpdate touches nothing but the layer's own state, since
+		// consecutive parallel layers update at the same time on the job system.
+		void SetParallelUpdate(bool parallel) { m_ParallelUpdate = parallel; }
+		bool IsParallelUpdate() const { return m_ParallelUpdate; }
+
+		// Orders this layer's update after any layer of type T. Implies SetParallelUpdate(true).
+		template<std::derived_from<Layer> T>
+		void AddUpdateDependency()
+		{
+			m_ParallelUpdate = true;
+			m_UpdateDependencies.push_back([](const Layer* layer) { return dynamic_cast<const T*>(layer) != nullptr; });
+		}
+
+		bool DependsOn(const Layer* layer) const;
+
+		// Application::RaiseEvent skips this layer for events outside these EventCategory bits
+		void SetEventCategories(int categories) { m_EventCategories = categories; }
+		int GetEventCategories() const { return m_EventCategories; }
+		bool IsSubscribedTo(const Event& event) const { return (event.GetCategoryFlags() & m_EventCategories) != 0; }
+
+		const std::string& GetName() const { return m_DebugName; }
 	private:
 		void QueueTransition(std::unique_ptr<Layer> layer);
 	private:
 		std::string m_DebugName;
+
+		bool m_ParallelUpdate = false;
+		std::vector<bool(*)(const Layer*)> m_UpdateDependencies;
+
+		int m_EventCategories = EventCategoryAll;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "RenderThread.h"
+
+#include "Debug/MemoryTracker.h"
+#include "Debug/Profiler.h"
+#include "Renderer/RenderCommandQueue.h"
+
+#include <GLFW/glfw3.h>
+
+namespace Core {
+
+	RenderThread::~RenderThread()
+	{
+		Terminate();
+	}
+
+	void RenderThread::Run(GLFWwindow* window)
+	{
+		PROFILE_FUNC();
+
+		if (m_Running)
+			return;
+
+		m_Window = window;
+		m_Running = true;
+		m_State = State::Idle;
+
+		// A context can only be current on one thread at a time
+		glfwMakeContextCurrent(nullptr);
+		m_Thread = std::thread(&RenderThread::ThreadFunc, this);
+	}
+
+	void RenderThread::Terminate()
+	{
+		PROFILE_FUNC();
+
+		if (!m_Running)
+			return;
+
+		WaitIdle();
+
+		{
+			std::scoped_lock lock(m_Mutex);
+			m_Running = false;
+		}
+		m_Condition.notify_all();
+
+		m_Thread.join();
+
+		glfwMakeContextCurrent(m_Window);
+	}
+
+	void RenderThread::NextFrame()
+	{
+		if (!m_Running)
+		{
+			Renderer::SwapQueues();
+			Renderer::ExecuteRenderQueue();
+			return;
+		}
+
+		{
+			// Time spent here means the render thread is the bottleneck
+			PROFILE_SCOPE("RenderThread::WaitForPreviousFrame");
+			WaitIdle();
+		}
+
+		Renderer::SwapQueues();
+
+		{
+			std::scoped_lock lock(m_Mutex);
+			m_State = State::Kick;
+		}
+		m_Condition.notify_all();
+	}
+
+	void RenderThread::WaitIdle()
+	{
+		std::unique_lock lock(m_Mutex);
+		m_Condition.wait(lock, [this]() { return m_State == State::Idle; });
+	}
+
+	void RenderThread::ThreadFunc()
+	{
+		PROFILE_THREAD("Render Thread");
+		SetAllocationThreadName("Render Thread");
+
+		glfwMakeContextCurrent(m_Window);
+
+		while (true)
+		{
+			{
+				std::unique_lock lock(m_Mutex);
+				m_Condition.wait(lock, [this]() { return m_State == State::Kick || !m_Running; });
+
+				if (m_State != State::Kick)
+					break;
+
+				m_State = State::Busy;
+			}
+
+			{
+				PROFILE_SCOPE("RenderThread::ExecuteFrame");
+				Renderer::ExecuteRenderQueue();
+			}
+
+			PROFILE_MARK_FRAME_NAMED("Render Thread");
+
+			{
+				std::scoped_lock lock(m_Mutex);
+				m_State = State::Idle;
+			}
+			m_Condition.notify_all();
+		}
+
+		glfwMakeContextCurrent(nullptr);
+	}
+
+}
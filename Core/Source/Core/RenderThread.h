@@ -0,0 +1,51 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+struct GLFWwindow;
+
+namespace Core {
+
+	// Owns the GL context while running and executes the previous frame's render
+	// commands while the main thread updates and records the next one.
+	class RenderThread
+	{
+	public:
+		RenderThread() = default;
+		~RenderThread();
+
+		// Moves the window's GL context over to the render thread. Must be called
+		// from the thread that currently has the context current.
+		void Run(GLFWwindow* window);
+		// Finishes the in-flight frame and hands the context back to the calling thread
+		void Terminate();
+
+		bool IsRunning() const { return m_Running; }
+
+		// Called by the main thread once a frame is recorded. Waits for the previous
+		// frame to finish, then kicks off the one just recorded. Without a running
+		// render thread the frame is executed inline.
+		void NextFrame();
+
+		// Blocks until the render thread has executed everything it was handed
+		void WaitIdle();
+	private:
+		void ThreadFunc();
+	private:
+		enum class State
+		{
+			Idle, Kick, Busy
+		};
+
+		GLFWwindow* m_Window = nullptr;
+		std::thread m_Thread;
+		bool m_Running = false;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		State m_State = State::Idle;
+	};
+
+}
@@ -0,0 +1,98 @@
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Renderer {
+
+	// The scale holds while the average is between this fraction of the target and the target
+	static constexpr double RaiseThreshold = 0.8;
+	// Frames averaged at a scale before it changes again
+	static constexpr uint32_t MinSamples = 8;
+	static constexpr double AverageWeight = 0.25;
+	// Scales snap to multiples of this so the scaled textures aren't reallocated for tiny changes
+	static constexpr float ScaleStep = 0.05f;
+	// Lowering goes straight to the estimate, raising at most this much at a time
+	static constexpr float MaxRaise = 0.1f;
+
+	static float SnapScale(float scale)
+	{
+		return std::floor(scale / ScaleStep + 0.001f) * ScaleStep;
+	}
+
+	void DynamicResolution::SetSettings(const DynamicResolutionSettings& settings)
+	{
+		m_Settings = settings;
+		m_Settings.MinScale = std::clamp(settings.MinScale, ScaleStep, 1.0f);
+		m_Settings.MaxScale = std::clamp(settings.MaxScale, m_Settings.MinScale, 1.0f);
+
+		m_Scale = m_Settings.Enabled ? std::clamp(m_Scale, m_Settings.MinScale, m_Settings.MaxScale) : m_Settings.MaxScale;
+		m_SampleCount = 0;
+	}
+
+	void DynamicResolution::Update(const Core::FrameTiming& latest, uint64_t nextFrameIndex)
+	{
+		if (!m_Settings.Enabled)
+		{
+			m_Scale = m_Settings.MaxScale;
+			return;
+		}
+
+		if (latest.GPUMillis < 0.0 || latest.FrameIndex < m_NextSampleFrame)
+			return;
+		m_NextSampleFrame = latest.FrameIndex + 1;
+
+		m_AverageGPUMillis = m_SampleCount == 0 ? latest.GPUMillis : m_AverageGPUMillis + (latest.GPUMillis - m_AverageGPUMillis) * AverageWeight;
+		m_SampleCount = std::min(m_SampleCount + 1, MinSamples);
+		if (m_SampleCount < MinSamples)
+			return;
+
+		const double target = m_Settings.TargetGPUMillis;
+
+		// GPU time goes with the pixel count, the square of the scale
+		const float estimate = m_Scale * (float)std::sqrt(target / std::max(m_AverageGPUMillis, 0.001));
+
+		float scale = m_Scale;
+		if (m_AverageGPUMillis > target)
+			scale = std::min(SnapScale(estimate), m_Scale - ScaleStep);
+		else if (m_AverageGPUMillis < target * RaiseThreshold)
+			scale = std::max(SnapScale(std::min(estimate, m_Scale + MaxRaise)), m_Scale);
+
+		scale = std::clamp(scale, m_Settings.MinScale, m_Settings.MaxScale);
+		if (scale == m_Scale)
+			return;
+
+		m_Scale = scale;
+		m_SampleCount = 0;
+		m_NextSampleFrame = nextFrameIndex;
+	}
+
+	glm::uvec2 DynamicResolution::GetScaledSize(glm::uvec2 size) const
+	{
+		return {
+			std::max((uint32_t)std::lround(size.x * m_Scale), 1u),
+			std::max((uint32_t)std::lround(size.y * m_Scale), 1u)
+		};
+	}
+
+	void AddUpscalePass(FrameGraph& graph, FrameGraphResource source, FrameGraphResource destination)
+	{
+		graph.AddPass("Upscale", [source, destination](FrameGraphBuilder& builder)
+		{
+			builder.Read(source, FrameGraphAccess::Transfer);
+			builder.Write(destination, FrameGraphAccess::Transfer);
+		},
+		[source, destination](const FrameGraphPassResources& resources)
+		{
+			const Framebuffer from = resources.GetFramebuffer(source);
+			const Framebuffer to = resources.GetFramebuffer(destination);
+			const bool sameSize = from.ColorAttachment.Width == to.ColorAttachment.Width && from.ColorAttachment.Height == to.ColorAttachment.Height;
+
+			glBlitNamedFramebuffer(from.Handle, to.Handle,
+				0, 0, from.ColorAttachment.Width, from.ColorAttachment.Height,
+				0, 0, to.ColorAttachment.Width, to.ColorAttachment.Height,
+				GL_COLOR_BUFFER_BIT, sameSize ? GL_NEAREST : GL_LINEAR);
+		});
+	}
+
+}
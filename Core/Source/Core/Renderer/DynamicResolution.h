@@ -0,0 +1,56 @@
+#pragma once
+
+#include "FrameGraph.h"
+
+#include "Core/Debug/FrameProfiler.h"
+
+#include <glm/glm.hpp>
+
+#include <stdint.h>
+
+namespace Renderer {
+
+	struct DynamicResolutionSettings
+	{
+		// Off keeps the scale at MaxScale
+		bool Enabled = true;
+		// GPU frame time to stay under. The scale drops as soon as the average goes over and
+		// only climbs back once it's comfortably below, see RaiseThreshold.
+		float TargetGPUMillis = 15.0f;
+		float MinScale = 0.5f;
+		float MaxScale = 1.0f;
+	};
+
+	// Picks the render scale of the heavy passes from the measured GPU frame time. Passes
+	// render into a target of GetScaledSize and AddUpscalePass stretches it back. Main thread.
+	class DynamicResolution
+	{
+	public:
+		void SetSettings(const DynamicResolutionSettings& settings);
+		const DynamicResolutionSettings& GetSettings() const { return m_Settings; }
+
+		// latest is the newest frame with a known GPU time, frames already seen are ignored.
+		// A new scale applies from nextFrameIndex on, earlier frames' times are not held
+		// against it.
+		void Update(const Core::FrameTiming& latest, uint64_t nextFrameIndex);
+
+		// Width and height factor, in [MinScale, MaxScale]
+		float GetScale() const { return m_Scale; }
+		// Smoothed GPU frame time, for a moment after a scale change still that of the previous scale
+		double GetAverageGPUMillis() const { return m_AverageGPUMillis; }
+
+		// size at the current scale, at least a pixel
+		glm::uvec2 GetScaledSize(glm::uvec2 size) const;
+	private:
+		DynamicResolutionSettings m_Settings;
+		float m_Scale = 1.0f;
+
+		double m_AverageGPUMillis = 0.0;
+		uint32_t m_SampleCount = 0;
+		uint64_t m_NextSampleFrame = 0;
+	};
+
+	// Adds a pass stretching source over destination with bilinear filtering
+	void AddUpscalePass(FrameGraph& graph, FrameGraphResource source, FrameGraphResource destination);
+
+}
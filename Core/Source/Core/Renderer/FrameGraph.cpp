@@ -0,0 +1,624 @@
+#include "FrameGraph.h"
+
+#include "FramebufferPool.h"
+#include "RenderState.h"
+
+#include "Core/Debug/GPUProfiler.h"
+#include "Core/Debug/Profiler.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <cstring>
+#include <iostream>
+
+namespace Renderer {
+
+	static constexpr uint32_t MaxColorAttachments = 8;
+
+	// Cached framebuffers unused for this many executions are deleted
+	static constexpr uint64_t PoolRetainExecutions = 4;
+
+	static constexpr uint32_t NoPass = ~0u;
+	static constexpr uint32_t NoSlot = ~0u;
+
+	struct PooledFramebuffer
+	{
+		GLuint Colors[MaxColorAttachments] = {};
+		uint32_t ColorCount = 0;
+		GLuint Depth = 0;
+		GLuint Handle = 0;
+		uint64_t LastUsed = 0;
+	};
+
+	struct FrameGraphPoolData
+	{
+		std::vector<PooledFramebuffer> Framebuffers;
+		uint64_t Execution = 0;
+		uint64_t TargetGeneration = 0; // FramebufferPool's when the framebuffers were last checked
+	};
+
+	static FrameGraphPoolData s_Pool;
+
+	static uint64_t GetTextureBytes(const FrameGraphTextureDesc& desc)
+	{
+		// Plus the resolve texture when multisampled
+		const uint64_t bytes = (uint64_t)desc.Width * desc.Height * GetBytesPerPixel(desc.Format);
+		return bytes * desc.Samples + (desc.Samples > 1 ? bytes : 0);
+	}
+
+	static GLbitfield GetBarrierBit(FrameGraphAccess access)
+	{
+		switch (access)
+		{
+		case FrameGraphAccess::Sampled:         return GL_TEXTURE_FETCH_BARRIER_BIT;
+		case FrameGraphAccess::Storage:         return GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+		case FrameGraphAccess::ColorAttachment:
+		case FrameGraphAccess::DepthAttachment: return GL_FRAMEBUFFER_BARRIER_BIT;
+		case FrameGraphAccess::Transfer:        return GL_FRAMEBUFFER_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT;
+		}
+		return GL_ALL_BARRIER_BITS;
+	}
+
+	static bool IsAttachment(FrameGraphAccess access)
+	{
+		return access == FrameGraphAccess::ColorAttachment || access == FrameGraphAccess::DepthAttachment;
+	}
+
+	static RenderTarget* AcquireTarget(const FrameGraphTextureDesc& desc)
+	{
+		const FramebufferFormat format = GetFramebufferFormat(desc.Format);
+		assert(format != FramebufferFormat::None && "FrameGraph transient format has no FramebufferFormat");
+
+		FramebufferSpec spec;
+		spec.Width = desc.Width;
+		spec.Height = desc.Height;
+		spec.Samples = desc.Samples;
+		if (IsDepthFormat(desc.Format))
+		{
+			spec.ColorFormats[0] = FramebufferFormat::None;
+			spec.DepthFormat = format;
+		}
+		else
+		{
+			spec.ColorFormats[0] = format;
+		}
+
+		return FramebufferPool::Acquire(spec);
+	}
+
+	static GLuint GetCachedFramebuffer(const GLuint* colors, uint32_t colorCount, GLuint depth, GLenum depthFormat)
+	{
+		for (PooledFramebuffer& framebuffer : s_Pool.Framebuffers)
+		{
+			if (framebuffer.ColorCount == colorCount && framebuffer.Depth == depth && std::equal(colors, colors + colorCount, framebuffer.Colors))
+			{
+				framebuffer.LastUsed = s_Pool.Execution;
+				return framebuffer.Handle;
+			}
+		}
+
+		PooledFramebuffer& framebuffer = s_Pool.Framebuffers.emplace_back();
+		std::copy(colors, colors + colorCount, framebuffer.Colors);
+		framebuffer.ColorCount = colorCount;
+		framebuffer.Depth = depth;
+		framebuffer.LastUsed = s_Pool.Execution;
+
+		GLenum drawBuffers[MaxColorAttachments];
+		glCreateFramebuffers(1, &framebuffer.Handle);
+		for (uint32_t i = 0; i < colorCount; i++)
+		{
+			glNamedFramebufferTexture(framebuffer.Handle, GL_COLOR_ATTACHMENT0 + i, colors[i], 0);
+			drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+		}
+		glNamedFramebufferDrawBuffers(framebuffer.Handle, colorCount, drawBuffers);
+
+		if (depth)
+		{
+			const bool stencil = depthFormat == GL_DEPTH24_STENCIL8 || depthFormat == GL_DEPTH32F_STENCIL8;
+			glNamedFramebufferTexture(framebuffer.Handle, stencil ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT, depth, 0);
+		}
+
+		if (glCheckNamedFramebufferStatus(framebuffer.Handle, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+			std::cerr << "FrameGraph framebuffer is not complete!" << std::endl;
+
+		return framebuffer.Handle;
+	}
+
+	template<typename Predicate>
+	static void DeleteFramebuffers(Predicate predicate)
+	{
+		const size_t pooled = s_Pool.Framebuffers.size();
+
+		std::erase_if(s_Pool.Framebuffers, [&](const PooledFramebuffer& framebuffer)
+		{
+			if (!predicate(framebuffer))
+				return false;
+
+			glDeleteFramebuffers(1, &framebuffer.Handle);
+			return true;
+		});
+
+		// GL unbinds what's deleted and may hand the names out again
+		if (s_Pool.Framebuffers.size() != pooled)
+			RenderState::Invalidate();
+	}
+
+	// Framebuffers are keyed by texture names, which the pool may have deleted and handed out again
+	static void DropStaleFramebuffers()
+	{
+		const uint64_t generation = FramebufferPool::GetGeneration();
+		if (generation == s_Pool.TargetGeneration)
+			return;
+
+		s_Pool.TargetGeneration = generation;
+		DeleteFramebuffers([](const PooledFramebuffer&) { return true; });
+	}
+
+	static void EvictUnused()
+	{
+		DeleteFramebuffers([](const PooledFramebuffer& framebuffer) { return framebuffer.LastUsed + PoolRetainExecutions < s_Pool.Execution; });
+	}
+
+	void FrameGraphBuilder::Read(FrameGraphResource resource, FrameGraphAccess access)
+	{
+		assert(resource < m_Graph.m_Resources.size());
+
+		m_Graph.m_Passes[m_Pass].Reads.push_back({ m_Graph.m_Resources[resource].LatestNode, access });
+	}
+
+	void FrameGraphBuilder::Write(FrameGraphResource resource, FrameGraphAccess access)
+	{
+		assert(resource < m_Graph.m_Resources.size());
+
+		const uint32_t node = m_Graph.AddNode(resource, m_Pass);
+		m_Graph.m_Resources[resource].LatestNode = node;
+		m_Graph.m_Passes[m_Pass].Writes.push_back({ node, access });
+
+		// Imported resources are seen outside the graph
+		if (m_Graph.m_Resources[resource].Imported)
+			m_Graph.m_Passes[m_Pass].SideEffect = true;
+	}
+
+	void FrameGraphBuilder::SetSideEffect()
+	{
+		m_Graph.m_Passes[m_Pass].SideEffect = true;
+	}
+
+	GLuint FrameGraphPassResources::GetTexture(FrameGraphResource resource) const
+	{
+		const uint32_t slot = m_Graph.m_Resources[resource].Slot;
+		return slot == NoSlot ? 0 : m_Graph.m_Slots[slot].Texture;
+	}
+
+	const FrameGraphTextureDesc& FrameGraphPassResources::GetDesc(FrameGraphResource resource) const
+	{
+		return m_Graph.m_Resources[resource].Desc;
+	}
+
+	Framebuffer FrameGraphPassResources::GetFramebuffer(FrameGraphResource resource) const
+	{
+		const FrameGraphTextureDesc& desc = GetDesc(resource);
+
+		Framebuffer result;
+		result.ColorAttachment = { GetTexture(resource), desc.Width, desc.Height };
+
+		if (m_Graph.m_Resources[resource].Backbuffer)
+			result.Handle = GetBackbuffer();
+		else if (result.ColorAttachment.Handle)
+			result.Handle = GetCachedFramebuffer(&result.ColorAttachment.Handle, 1, 0, GL_NONE);
+
+		return result;
+	}
+
+	FrameGraphResource FrameGraph::CreateTexture(const char* name, const FrameGraphTextureDesc& desc)
+	{
+		const FrameGraphResource resource = (FrameGraphResource)m_Resources.size();
+
+		Resource& entry = m_Resources.emplace_back();
+		entry.Name = name;
+		entry.Desc = desc;
+		entry.Desc.Width = std::max(desc.Width, 1u);
+		entry.Desc.Height = std::max(desc.Height, 1u);
+		entry.LatestNode = AddNode(resource, NoPass);
+
+		return resource;
+	}
+
+	FrameGraphResource FrameGraph::ImportTexture(const char* name, GLuint texture, const FrameGraphTextureDesc& desc)
+	{
+		const FrameGraphResource resource = CreateTexture(name, desc);
+		m_Resources[resource].ImportedTexture = texture;
+		m_Resources[resource].Imported = true;
+		return resource;
+	}
+
+	FrameGraphResource FrameGraph::ImportBackbuffer(const char* name, uint32_t width, uint32_t height)
+	{
+		const FrameGraphResource resource = ImportTexture(name, 0, { width, height, GL_RGBA8 });
+		m_Resources[resource].Backbuffer = true;
+		return resource;
+	}
+
+	void FrameGraph::AddPass(const char* name, const SetupFunc& setup, ExecuteFunc execute)
+	{
+		assert(!m_Compiled && "AddPass after Compile, Reset the graph first");
+
+		const uint32_t pass = (uint32_t)m_Passes.size();
+		m_Passes.emplace_back();
+		m_Passes[pass].Name = name;
+		m_Passes[pass].Execute = std::move(execute);
+
+		FrameGraphBuilder builder(*this, pass);
+		setup(builder);
+	}
+
+	bool FrameGraph::IsWritten(FrameGraphResource resource) const
+	{
+		return m_Nodes[m_Resources[resource].LatestNode].Producer != NoPass;
+	}
+
+	const FrameGraphTextureDesc& FrameGraph::GetDesc(FrameGraphResource resource) const
+	{
+		return m_Resources[resource].Desc;
+	}
+
+	uint32_t FrameGraph::AddNode(FrameGraphResource resource, uint32_t producer)
+	{
+		m_Nodes.push_back({ resource, producer, 0 });
+		return (uint32_t)m_Nodes.size() - 1;
+	}
+
+	void FrameGraph::CullPasses()
+	{
+		for (Node& node : m_Nodes)
+			node.RefCount = 0;
+
+		for (Pass& pass : m_Passes)
+		{
+			pass.RefCount = (uint32_t)pass.Writes.size() + (pass.SideEffect ? 1 : 0);
+			pass.Culled = false;
+
+			for (const Access& read : pass.Reads)
+				m_Nodes[read.Node].RefCount++;
+		}
+
+		// Passes nothing keeps alive let go of their reads here, the node scan below then seeds
+		// the walk with each node nobody reads exactly once
+		for (Pass& pass : m_Passes)
+		{
+			if (pass.RefCount != 0)
+				continue;
+
+			pass.Culled = true;
+			for (const Access& read : pass.Reads)
+				m_Nodes[read.Node].RefCount--;
+		}
+
+		// Walk back from the nodes nobody reads, a pass goes once none of its writes are read
+		std::vector<uint32_t> unreferenced;
+		auto cull = [&](Pass& pass)
+		{
+			pass.Culled = true;
+			for (const Access& read : pass.Reads)
+			{
+				if (--m_Nodes[read.Node].RefCount == 0)
+					unreferenced.push_back(read.Node);
+			}
+		};
+
+		for (uint32_t node = 0; node < (uint32_t)m_Nodes.size(); node++)
+		{
+			if (m_Nodes[node].RefCount == 0)
+				unreferenced.push_back(node);
+		}
+
+		while (!unreferenced.empty())
+		{
+			const Node& node = m_Nodes[unreferenced.back()];
+			unreferenced.pop_back();
+
+			if (node.Producer == NoPass)
+				continue;
+
+			Pass& producer = m_Passes[node.Producer];
+			if (!producer.Culled && --producer.RefCount == 0)
+				cull(producer);
+		}
+	}
+
+	void FrameGraph::AssignSlots()
+	{
+		for (Resource& resource : m_Resources)
+		{
+			resource.FirstPass = NoPass;
+			resource.LastPass = 0;
+			resource.Slot = NoSlot;
+		}
+
+		for (uint32_t passIndex = 0; passIndex < (uint32_t)m_Passes.size(); passIndex++)
+		{
+			const Pass& pass = m_Passes[passIndex];
+			if (pass.Culled)
+				continue;
+
+			auto use = [&](const Access& access)
+			{
+				const Node& node = m_Nodes[access.Node];
+				Resource& resource = m_Resources[node.Resource];
+
+				if (resource.FirstPass == NoPass)
+				{
+					resource.FirstPass = passIndex;
+
+					static bool s_Warned = false;
+					if (!resource.Imported && node.Producer == NoPass && !s_Warned)
+					{
+						std::cerr << "FrameGraph: pass " << pass.Name << " reads " << resource.Name << " before anything writes it" << std::endl;
+						s_Warned = true;
+					}
+				}
+				resource.LastPass = passIndex;
+			};
+
+			std::for_each(pass.Reads.begin(), pass.Reads.end(), use);
+			std::for_each(pass.Writes.begin(), pass.Writes.end(), use);
+		}
+
+		// Transients take a free slot of the same desc when their lifetime starts and give it
+		// back once it ends, in execution order
+		std::vector<uint32_t> freeSlots;
+
+		for (uint32_t passIndex = 0; passIndex < (uint32_t)m_Passes.size(); passIndex++)
+		{
+			if (m_Passes[passIndex].Culled)
+				continue;
+
+			for (Resource& resource : m_Resources)
+			{
+				if (resource.FirstPass != passIndex)
+					continue;
+
+				m_Stats.UnaliasedBytes += resource.Imported ? 0 : GetTextureBytes(resource.Desc);
+				m_Stats.TransientResources += resource.Imported ? 0 : 1;
+
+				auto freeSlot = std::find_if(freeSlots.begin(), freeSlots.end(), [&](uint32_t slot) { return m_Slots[slot].Desc == resource.Desc; });
+				if (!resource.Imported && freeSlot != freeSlots.end())
+				{
+					resource.Slot = *freeSlot;
+					freeSlots.erase(freeSlot);
+					continue;
+				}
+
+				resource.Slot = (uint32_t)m_Slots.size();
+
+				Slot& slot = m_Slots.emplace_back();
+				slot.Desc = resource.Desc;
+				slot.ImportedTexture = resource.ImportedTexture;
+				slot.Backbuffer = resource.Backbuffer;
+
+				if (!resource.Imported)
+				{
+					m_Stats.TransientTextures++;
+					m_Stats.TransientBytes += GetTextureBytes(resource.Desc);
+				}
+			}
+
+			for (const Resource& resource : m_Resources)
+			{
+				if (resource.LastPass == passIndex && resource.FirstPass != NoPass && !resource.Imported)
+					freeSlots.push_back(resource.Slot);
+			}
+		}
+	}
+
+	void FrameGraph::PlaceBarriers()
+	{
+		// Image stores are the only writes GL doesn't order against later accesses
+		struct SlotSync
+		{
+			bool PendingStore = false;
+			GLbitfield Synced = 0; // Barrier bits issued since the store
+		};
+		std::vector<SlotSync> sync(m_Slots.size());
+
+		for (Pass& pass : m_Passes)
+		{
+			pass.Barrier = 0;
+			if (pass.Culled)
+				continue;
+
+			auto check = [&](const Access& access)
+			{
+				const SlotSync& slot = sync[m_Resources[m_Nodes[access.Node].Resource].Slot];
+				const GLbitfield bit = GetBarrierBit(access.Type);
+				if (slot.PendingStore && (slot.Synced & bit) != bit)
+					pass.Barrier |= bit;
+			};
+
+			std::for_each(pass.Reads.begin(), pass.Reads.end(), check);
+			std::for_each(pass.Writes.begin(), pass.Writes.end(), check);
+
+			// A barrier covers every store before it
+			if (pass.Barrier)
+			{
+				m_Stats.Barriers++;
+				for (SlotSync& slot : sync)
+				{
+					if (slot.PendingStore)
+						slot.Synced |= pass.Barrier;
+				}
+			}
+
+			for (const Access& write : pass.Writes)
+			{
+				if (write.Type == FrameGraphAccess::Storage)
+					sync[m_Resources[m_Nodes[write.Node].Resource].Slot] = { true, 0 };
+			}
+		}
+	}
+
+	void FrameGraph::Compile()
+	{
+		PROFILE_FUNC();
+
+		assert(!m_Compiled && "FrameGraph compiled twice");
+
+		m_Stats = {};
+		m_Slots.clear();
+
+		CullPasses();
+		AssignSlots();
+		PlaceBarriers();
+
+		for (const Pass& pass : m_Passes)
+		{
+			m_Stats.Passes += pass.Culled ? 0 : 1;
+			m_Stats.CulledPasses += pass.Culled ? 1 : 0;
+		}
+
+		m_Compiled = true;
+	}
+
+	GLuint FrameGraph::GetPassFramebuffer(const Pass& pass) const
+	{
+		GLuint colors[MaxColorAttachments];
+		uint32_t colorCount = 0;
+		GLuint depth = 0;
+		GLenum depthFormat = GL_NONE;
+
+		auto attach = [&](const Access& access)
+		{
+			if (!IsAttachment(access.Type))
+				return true;
+
+			const Resource& resource = m_Resources[m_Nodes[access.Node].Resource];
+			if (resource.Backbuffer)
+				return false;
+
+			const GLuint texture = m_Slots[resource.Slot].Attachment;
+			if (access.Type == FrameGraphAccess::DepthAttachment)
+			{
+				depth = texture;
+				depthFormat = resource.Desc.Format;
+			}
+			else if (std::find(colors, colors + colorCount, texture) == colors + colorCount && colorCount < MaxColorAttachments)
+			{
+				colors[colorCount++] = texture;
+			}
+			return true;
+		};
+
+		// Writes first so their order decides the color attachment indices
+		for (const Access& write : pass.Writes)
+		{
+			if (!attach(write))
+				return GetBackbuffer();
+		}
+		for (const Access& read : pass.Reads)
+		{
+			if (!attach(read))
+				return GetBackbuffer();
+		}
+
+		if (colorCount == 0 && !depth)
+			return 0;
+
+		return GetCachedFramebuffer(colors, colorCount, depth, depthFormat);
+	}
+
+	void FrameGraph::Execute()
+	{
+		PROFILE_FUNC();
+
+		assert(m_Compiled && "FrameGraph executed without Compile");
+
+		s_Pool.Execution++;
+
+		for (Slot& slot : m_Slots)
+		{
+			slot.Target = nullptr;
+			slot.Unresolved = false;
+
+			if (slot.Backbuffer)
+			{
+				slot.Texture = slot.Attachment = 0;
+			}
+			else if (slot.ImportedTexture)
+			{
+				slot.Texture = slot.Attachment = slot.ImportedTexture;
+			}
+			else
+			{
+				slot.Target = AcquireTarget(slot.Desc);
+				const bool depth = IsDepthFormat(slot.Desc.Format);
+				slot.Texture = depth ? slot.Target->GetDepthAttachment() : slot.Target->GetColorAttachment().Handle;
+				slot.Attachment = depth ? slot.Target->GetDepthAttachment() : slot.Target->GetColorBuffer();
+			}
+		}
+
+		// After acquiring, which may have resized targets
+		DropStaleFramebuffers();
+
+		for (const Pass& pass : m_Passes)
+		{
+			if (pass.Culled)
+				continue;
+
+			PROFILE_SCOPE_DYNAMIC(pass.Name);
+#if ENABLE_PROFILING
+			TracyGpuZoneTransient(___tracy_gpu_zone, pass.Name, true);
+#endif
+			Core::GPUScope gpuScope(pass.Name);
+
+			if (pass.Barrier)
+				glMemoryBarrier(pass.Barrier);
+
+			// Multisampled targets are resolved once before anything but drawing touches them
+			for (const Access& read : pass.Reads)
+			{
+				Slot& slot = m_Slots[m_Resources[m_Nodes[read.Node].Resource].Slot];
+				if (slot.Unresolved && !IsAttachment(read.Type))
+				{
+					slot.Target->Resolve();
+					slot.Unresolved = false;
+				}
+			}
+
+			pass.Execute(FrameGraphPassResources(*this, GetPassFramebuffer(pass)));
+
+			for (const Access& write : pass.Writes)
+			{
+				Slot& slot = m_Slots[m_Resources[m_Nodes[write.Node].Resource].Slot];
+				if (slot.Target && slot.Desc.Samples > 1 && IsAttachment(write.Type))
+					slot.Unresolved = true;
+			}
+		}
+
+		for (Slot& slot : m_Slots)
+		{
+			FramebufferPool::Release(slot.Target);
+			slot.Target = nullptr;
+		}
+
+		EvictUnused();
+	}
+
+	void FrameGraph::Reset()
+	{
+		m_Resources.clear();
+		m_Nodes.clear();
+		m_Passes.clear();
+		m_Slots.clear();
+		m_Compiled = false;
+		m_Stats = {};
+	}
+
+	void ShutdownFrameGraph()
+	{
+		for (const PooledFramebuffer& framebuffer : s_Pool.Framebuffers)
+			glDeleteFramebuffers(1, &framebuffer.Handle);
+
+		s_Pool.Framebuffers.clear();
+	}
+
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "Renderer.h"
+
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+namespace Renderer {
+
+	// Index of a texture in its FrameGraph, stable across writes
+	using FrameGraphResource = uint32_t;
+	constexpr FrameGraphResource InvalidFrameGraphResource = ~0u;
+
+	enum class FrameGraphAccess
+	{
+		Sampled,         // Texture fetches
+		Storage,         // Image load/store
+		ColorAttachment, // In the pass's framebuffer, in declaration order
+		DepthAttachment,
+		Transfer         // Blits and copies
+	};
+
+	struct FrameGraphTextureDesc
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		GLenum Format = GL_RGBA8; // One of the FramebufferFormats for transients
+		// Above 1 passes draw into it multisampled, and any other access sees it resolved
+		uint32_t Samples = 1;
+
+		bool operator==(const FrameGraphTextureDesc&) const = default;
+	};
+
+	struct FrameGraphStats
+	{
+		uint32_t Passes = 0;          // Executed
+		uint32_t CulledPasses = 0;
+		uint32_t TransientResources = 0;
+		uint32_t TransientTextures = 0; // After aliasing
+		uint32_t Barriers = 0;        // glMemoryBarrier calls
+		uint64_t TransientBytes = 0;  // Peak transient memory, every aliased texture is alive for the whole frame
+		uint64_t UnaliasedBytes = 0;  // What the transients would take with a texture each
+	};
+
+	class FrameGraph;
+	class RenderTarget;
+
+	// Handed to a pass's setup to declare what it reads and writes
+	class FrameGraphBuilder
+	{
+	public:
+		// Reads the latest write to resource
+		void Read(FrameGraphResource resource, FrameGraphAccess access = FrameGraphAccess::Sampled);
+		// Passes that read the new contents depend on this one. Blending onto earlier contents
+		// needs a Read as well.
+		void Write(FrameGraphResource resource, FrameGraphAccess access = FrameGraphAccess::ColorAttachment);
+		// Never culled, for passes with effects the graph can't see
+		void SetSideEffect();
+	private:
+		FrameGraphBuilder(FrameGraph& graph, uint32_t pass) : m_Graph(graph), m_Pass(pass) {}
+
+		FrameGraph& m_Graph;
+		uint32_t m_Pass;
+
+		friend class FrameGraph;
+	};
+
+	// Handed to a pass's execute on the GL thread
+	class FrameGraphPassResources
+	{
+	public:
+		GLuint GetTexture(FrameGraphResource resource) const;
+		const FrameGraphTextureDesc& GetDesc(FrameGraphResource resource) const;
+
+		// The pass's attachments, or the backbuffer when it writes that
+		GLuint GetFramebuffer() const { return m_Framebuffer; }
+		// resource alone as color attachment 0, e.g. for BlitFramebufferToSwapchain
+		Framebuffer GetFramebuffer(FrameGraphResource resource) const;
+	private:
+		FrameGraphPassResources(const FrameGraph& graph, GLuint framebuffer) : m_Graph(graph), m_Framebuffer(framebuffer) {}
+
+		const FrameGraph& m_Graph;
+		GLuint m_Framebuffer;
+
+		friend class FrameGraph;
+	};
+
+	// Passes declare the textures they read and write, Compile culls the passes nobody
+	// depends on, works out how long each transient texture lives and lets transients with
+	// disjoint lifetimes share a texture, and places memory barriers after image stores
+	// only where a later access needs them. Passes execute in the order they were added.
+	//
+	// Built and compiled on any one thread, Execute runs on the GL thread. Transient textures
+	// are FramebufferPool targets, so they're kept across frames and shared with everything
+	// else that renders offscreen. Names must outlive the graph, i.e. string literals.
+	class FrameGraph
+	{
+	public:
+		using SetupFunc = std::function<void(FrameGraphBuilder&)>;
+		using ExecuteFunc = std::function<void(const FrameGraphPassResources&)>;
+
+		FrameGraphResource CreateTexture(const char* name, const FrameGraphTextureDesc& desc);
+		FrameGraphResource ImportTexture(const char* name, GLuint texture, const FrameGraphTextureDesc& desc);
+		// See GetBackbuffer. Passes writing it are never culled.
+		FrameGraphResource ImportBackbuffer(const char* name, uint32_t width, uint32_t height);
+
+		// setup runs right away, execute when the graph executes
+		void AddPass(const char* name, const SetupFunc& setup, ExecuteFunc execute);
+
+		// Whether any pass added so far writes resource
+		bool IsWritten(FrameGraphResource resource) const;
+		const FrameGraphTextureDesc& GetDesc(FrameGraphResource resource) const;
+
+		void Compile();
+		void Execute();
+		// Drops every pass and resource, keeps the storage
+		void Reset();
+
+		// Of the last Compile
+		const FrameGraphStats& GetStats() const { return m_Stats; }
+	private:
+		struct Resource
+		{
+			const char* Name = nullptr;
+			FrameGraphTextureDesc Desc;
+			GLuint ImportedTexture = 0;
+			bool Imported = false;
+			bool Backbuffer = false;
+			uint32_t LatestNode = 0;
+
+			// Compiled
+			uint32_t FirstPass = ~0u;
+			uint32_t LastPass = 0;
+			uint32_t Slot = ~0u; // Texture it's given at execution
+		};
+
+		// A version of a resource, every write makes a new one
+		struct Node
+		{
+			FrameGraphResource Resource = 0;
+			uint32_t Producer = ~0u;
+			uint32_t RefCount = 0;
+		};
+
+		struct Access
+		{
+			uint32_t Node = 0;
+			FrameGraphAccess Type = FrameGraphAccess::Sampled;
+		};
+
+		struct Pass
+		{
+			const char* Name = nullptr;
+			ExecuteFunc Execute;
+			std::vector<Access> Reads;
+			std::vector<Access> Writes;
+			bool SideEffect = false;
+
+			// Compiled
+			uint32_t RefCount = 0;
+			bool Culled = false;
+			GLbitfield Barrier = 0;
+		};
+
+		struct Slot
+		{
+			FrameGraphTextureDesc Desc;
+			GLuint ImportedTexture = 0; // Imported resources get a slot of their own
+			bool Backbuffer = false;
+
+			// While executing
+			RenderTarget* Target = nullptr;
+			GLuint Texture = 0;         // Resolved when multisampled
+			GLuint Attachment = 0;      // What passes draw into
+			bool Unresolved = false;    // Drawn into since the last resolve
+		};
+
+		uint32_t AddNode(FrameGraphResource resource, uint32_t producer);
+		void CullPasses();
+		void AssignSlots();
+		void PlaceBarriers();
+		GLuint GetPassFramebuffer(const Pass& pass) const;
+
+		std::vector<Resource> m_Resources;
+		std::vector<Node> m_Nodes;
+		std::vector<Pass> m_Passes;
+		std::vector<Slot> m_Slots;
+		bool m_Compiled = false;
+
+		FrameGraphStats m_Stats;
+
+		friend class FrameGraphBuilder;
+		friend class FrameGraphPassResources;
+	};
+
+	// GL thread, releases the cached pass framebuffers
+	void ShutdownFrameGraph();
+
+}
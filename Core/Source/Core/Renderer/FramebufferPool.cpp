@@ -0,0 +1,346 @@
+#include "FramebufferPool.h"
+
+#include "RenderState.h"
+
+#include "Core/Debug/Profiler.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <iostream>
+
+namespace Renderer {
+
+	// Idle targets are deleted after this many frames
+	static constexpr uint64_t RetainFrames = 4;
+
+	static constexpr uint32_t FramebufferFormatCount = (uint32_t)FramebufferFormat::Depth32F + 1;
+
+	struct FramebufferPoolData
+	{
+		std::vector<std::unique_ptr<RenderTarget>> Targets;
+		uint64_t Frame = 0;
+		uint64_t Generation = 0;
+		FramebufferPoolStats Stats;
+
+		// Multisampled texture sample counts per format, descending, queried on first use
+		std::vector<GLint> SampleCounts[FramebufferFormatCount];
+	};
+
+	static FramebufferPoolData s_Data;
+
+	GLenum GetInternalFormat(FramebufferFormat format)
+	{
+		switch (format)
+		{
+		case FramebufferFormat::RGBA8:           return GL_RGBA8;
+		case FramebufferFormat::RGBA16F:         return GL_RGBA16F;
+		case FramebufferFormat::R11G11B10F:      return GL_R11F_G11F_B10F;
+		case FramebufferFormat::RGBA32F:         return GL_RGBA32F;
+		case FramebufferFormat::Depth24Stencil8: return GL_DEPTH24_STENCIL8;
+		case FramebufferFormat::Depth32F:        return GL_DEPTH_COMPONENT32F;
+		case FramebufferFormat::None:            break;
+		}
+		return GL_NONE;
+	}
+
+	FramebufferFormat GetFramebufferFormat(GLenum internalFormat)
+	{
+		for (uint32_t i = 1; i < FramebufferFormatCount; i++)
+		{
+			if (GetInternalFormat((FramebufferFormat)i) == internalFormat)
+				return (FramebufferFormat)i;
+		}
+		return FramebufferFormat::None;
+	}
+
+	uint32_t FramebufferSpec::GetColorCount() const
+	{
+		uint32_t count = 0;
+		while (count < MaxFramebufferColorAttachments && ColorFormats[count] != FramebufferFormat::None)
+			count++;
+		return count;
+	}
+
+	bool FramebufferSpec::IsCompatible(const FramebufferSpec& other) const
+	{
+		return std::equal(std::begin(ColorFormats), std::end(ColorFormats), std::begin(other.ColorFormats))
+			&& DepthFormat == other.DepthFormat && Samples == other.Samples;
+	}
+
+	static GLuint CreateAttachment(GLenum format, uint32_t width, uint32_t height, uint32_t samples)
+	{
+		GLuint texture = 0;
+
+		if (samples > 1)
+		{
+			glCreateTextures(GL_TEXTURE_2D_MULTISAMPLE, 1, &texture);
+			glTextureStorage2DMultisample(texture, samples, format, width, height, GL_TRUE);
+			return texture;
+		}
+
+		const GLint filter = IsDepthFormat(format) ? GL_NEAREST : GL_LINEAR;
+		glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+		glTextureStorage2D(texture, 1, format, width, height);
+		glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, filter);
+		glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, filter);
+		glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		return texture;
+	}
+
+	static GLuint CreateFramebuffer(const GLuint* colors, uint32_t colorCount, GLuint depth, FramebufferFormat depthFormat)
+	{
+		GLuint framebuffer = 0;
+		glCreateFramebuffers(1, &framebuffer);
+
+		GLenum drawBuffers[MaxFramebufferColorAttachments];
+		for (uint32_t i = 0; i < colorCount; i++)
+		{
+			glNamedFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0 + i, colors[i], 0);
+			drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+		}
+		glNamedFramebufferDrawBuffers(framebuffer, colorCount, drawBuffers);
+
+		if (depth)
+			glNamedFramebufferTexture(framebuffer, depthFormat == FramebufferFormat::Depth24Stencil8 ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT, depth, 0);
+
+		if (glCheckNamedFramebufferStatus(framebuffer, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+			std::cerr << "Render target framebuffer is not complete!" << std::endl;
+
+		return framebuffer;
+	}
+
+	RenderTarget::~RenderTarget()
+	{
+		Destroy();
+	}
+
+	void RenderTarget::Create(const FramebufferSpec& spec)
+	{
+		PROFILE_FUNC();
+
+		m_Spec = spec;
+
+		const uint32_t colorCount = m_Spec.GetColorCount();
+		for (uint32_t i = 0; i < colorCount; i++)
+			m_ColorAttachments[i] = CreateAttachment(GetInternalFormat(m_Spec.ColorFormats[i]), m_Spec.Width, m_Spec.Height, m_Spec.Samples);
+
+		if (m_Spec.DepthFormat != FramebufferFormat::None)
+			m_DepthAttachment = CreateAttachment(GetInternalFormat(m_Spec.DepthFormat), m_Spec.Width, m_Spec.Height, m_Spec.Samples);
+
+		m_Framebuffer = CreateFramebuffer(m_ColorAttachments, colorCount, m_DepthAttachment, m_Spec.DepthFormat);
+
+		if (m_Spec.Samples > 1)
+		{
+			for (uint32_t i = 0; i < colorCount; i++)
+				m_ResolvedColorAttachments[i] = CreateAttachment(GetInternalFormat(m_Spec.ColorFormats[i]), m_Spec.Width, m_Spec.Height, 1);
+
+			m_ResolveFramebuffer = CreateFramebuffer(m_ResolvedColorAttachments, colorCount, 0, FramebufferFormat::None);
+		}
+	}
+
+	void RenderTarget::Destroy()
+	{
+		if (!m_Framebuffer)
+			return;
+
+		glDeleteFramebuffers(1, &m_Framebuffer);
+		glDeleteFramebuffers(1, &m_ResolveFramebuffer);
+		glDeleteTextures(MaxFramebufferColorAttachments, m_ColorAttachments);
+		glDeleteTextures(MaxFramebufferColorAttachments, m_ResolvedColorAttachments);
+		glDeleteTextures(1, &m_DepthAttachment);
+
+		m_Framebuffer = 0;
+		m_ResolveFramebuffer = 0;
+		std::fill(std::begin(m_ColorAttachments), std::end(m_ColorAttachments), 0);
+		std::fill(std::begin(m_ResolvedColorAttachments), std::end(m_ResolvedColorAttachments), 0);
+		m_DepthAttachment = 0;
+
+		// GL unbinds what's deleted and may hand the names out again
+		RenderState::Invalidate();
+		s_Data.Generation++;
+	}
+
+	Texture RenderTarget::GetColorAttachment(uint32_t index) const
+	{
+		assert(index < MaxFramebufferColorAttachments);
+
+		const GLuint handle = m_Spec.Samples > 1 ? m_ResolvedColorAttachments[index] : m_ColorAttachments[index];
+		return { handle, m_Spec.Width, m_Spec.Height };
+	}
+
+	Framebuffer RenderTarget::GetResolvedFramebuffer() const
+	{
+		return { m_Spec.Samples > 1 ? m_ResolveFramebuffer : m_Framebuffer, GetColorAttachment(0) };
+	}
+
+	void RenderTarget::Resolve()
+	{
+		if (m_Spec.Samples <= 1)
+			return;
+
+		PROFILE_FUNC();
+
+		const uint32_t colorCount = m_Spec.GetColorCount();
+		for (uint32_t i = 0; i < colorCount; i++)
+		{
+			glNamedFramebufferReadBuffer(m_Framebuffer, GL_COLOR_ATTACHMENT0 + i);
+			glNamedFramebufferDrawBuffer(m_ResolveFramebuffer, GL_COLOR_ATTACHMENT0 + i);
+			glBlitNamedFramebuffer(m_Framebuffer, m_ResolveFramebuffer,
+				0, 0, m_Spec.Width, m_Spec.Height, 0, 0, m_Spec.Width, m_Spec.Height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+		}
+
+		// Back to the defaults, reads of the resolved target go through attachment 0
+		glNamedFramebufferReadBuffer(m_Framebuffer, GL_COLOR_ATTACHMENT0);
+		glNamedFramebufferReadBuffer(m_ResolveFramebuffer, GL_COLOR_ATTACHMENT0);
+	}
+
+	uint64_t RenderTarget::GetMemoryBytes() const
+	{
+		const uint64_t pixels = (uint64_t)m_Spec.Width * m_Spec.Height;
+
+		uint64_t bytes = 0;
+		for (uint32_t i = 0; i < m_Spec.GetColorCount(); i++)
+		{
+			const uint64_t attachment = pixels * GetBytesPerPixel(GetInternalFormat(m_Spec.ColorFormats[i]));
+			bytes += attachment * m_Spec.Samples + (m_Spec.Samples > 1 ? attachment : 0);
+		}
+
+		if (m_Spec.DepthFormat != FramebufferFormat::None)
+			bytes += pixels * GetBytesPerPixel(GetInternalFormat(m_Spec.DepthFormat)) * m_Spec.Samples;
+
+		return bytes;
+	}
+
+	// The highest count up to samples that format supports, GL_MAX_SAMPLES alone overstates it
+	// for e.g. float formats on some drivers
+	static uint32_t GetSupportedSamples(FramebufferFormat format, uint32_t samples)
+	{
+		std::vector<GLint>& counts = s_Data.SampleCounts[(uint32_t)format];
+		if (counts.empty())
+		{
+			GLint count = 0;
+			glGetInternalformativ(GL_TEXTURE_2D_MULTISAMPLE, GetInternalFormat(format), GL_NUM_SAMPLE_COUNTS, 1, &count);
+
+			counts.resize(std::max(count, 0) + 1);
+			if (count > 0)
+				glGetInternalformativ(GL_TEXTURE_2D_MULTISAMPLE, GetInternalFormat(format), GL_SAMPLES, count, counts.data());
+			// Single-sample always works and keeps the list non-empty
+			counts.back() = 1;
+		}
+
+		for (GLint count : counts)
+		{
+			if ((uint32_t)count <= samples)
+				return (uint32_t)count;
+		}
+		return 1;
+	}
+
+	// What the target will actually have, so requests the driver can't honour still match it
+	static FramebufferSpec NormalizeSpec(const FramebufferSpec& spec)
+	{
+		FramebufferSpec result = spec;
+		result.Width = std::max(spec.Width, 1u);
+		result.Height = std::max(spec.Height, 1u);
+		result.Samples = std::max(spec.Samples, 1u);
+
+		// Every attachment needs the same count, lower it until all of them support it
+		uint32_t samples = 0;
+		while (result.Samples > 1 && result.Samples != samples)
+		{
+			samples = result.Samples;
+			for (uint32_t i = 0; i < result.GetColorCount(); i++)
+				result.Samples = GetSupportedSamples(result.ColorFormats[i], result.Samples);
+			if (result.DepthFormat != FramebufferFormat::None)
+				result.Samples = GetSupportedSamples(result.DepthFormat, result.Samples);
+		}
+		return result;
+	}
+
+	RenderTarget* FramebufferPool::Acquire(const FramebufferSpec& requestedSpec)
+	{
+		const FramebufferSpec spec = NormalizeSpec(requestedSpec);
+		RenderTarget* resizable = nullptr;
+
+		for (const std::unique_ptr<RenderTarget>& target : s_Data.Targets)
+		{
+			if (target->m_InUse || !target->m_Spec.IsCompatible(spec))
+				continue;
+
+			if (target->m_Spec == spec)
+			{
+				target->m_InUse = true;
+				target->m_LastUsedFrame = s_Data.Frame;
+				s_Data.Stats.Reused++;
+				return target.get();
+			}
+
+			if (!resizable)
+				resizable = target.get();
+		}
+
+		RenderTarget* target = resizable;
+		if (target)
+		{
+			target->Destroy();
+			s_Data.Stats.Resized++;
+		}
+		else
+		{
+			target = s_Data.Targets.emplace_back(new RenderTarget()).get();
+			s_Data.Stats.Created++;
+		}
+
+		target->Create(spec);
+		target->m_InUse = true;
+		target->m_LastUsedFrame = s_Data.Frame;
+		return target;
+	}
+
+	void FramebufferPool::Release(RenderTarget* target)
+	{
+		if (!target)
+			return;
+
+		assert(target->m_InUse && "RenderTarget released twice");
+		target->m_InUse = false;
+		target->m_LastUsedFrame = s_Data.Frame;
+	}
+
+	void FramebufferPool::NextFrame()
+	{
+		s_Data.Frame++;
+
+		std::erase_if(s_Data.Targets, [](const std::unique_ptr<RenderTarget>& target)
+		{
+			const bool expired = !target->m_InUse && target->m_LastUsedFrame + RetainFrames < s_Data.Frame;
+			s_Data.Stats.Deleted += expired ? 1 : 0;
+			return expired;
+		});
+	}
+
+	void FramebufferPool::Shutdown()
+	{
+		s_Data.Targets.clear();
+		for (std::vector<GLint>& counts : s_Data.SampleCounts)
+			counts.clear();
+	}
+
+	uint64_t FramebufferPool::GetGeneration()
+	{
+		return s_Data.Generation;
+	}
+
+	FramebufferPoolStats FramebufferPool::GetStats()
+	{
+		FramebufferPoolStats stats = s_Data.Stats;
+		stats.Targets = (uint32_t)s_Data.Targets.size();
+
+		for (const std::unique_ptr<RenderTarget>& target : s_Data.Targets)
+			stats.MemoryBytes += target->GetMemoryBytes();
+
+		return stats;
+	}
+
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Renderer.h"
+
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+namespace Renderer {
+
+	constexpr uint32_t MaxFramebufferColorAttachments = 4;
+
+	enum class FramebufferFormat : uint8_t
+	{
+		None = 0,
+		RGBA8,           // 4 bytes per pixel
+		RGBA16F,         // 8, HDR with alpha
+		R11G11B10F,      // 4, HDR without alpha
+		RGBA32F,         // 16
+		Depth24Stencil8, // 4
+		Depth32F         // 4
+	};
+
+	GLenum GetInternalFormat(FramebufferFormat format);
+	// None when no FramebufferFormat has internalFormat
+	FramebufferFormat GetFramebufferFormat(GLenum internalFormat);
+
+	struct FramebufferSpec
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		// Attachments 0..n, up to the first None
+		FramebufferFormat ColorFormats[MaxFramebufferColorAttachments] = { FramebufferFormat::RGBA8 };
+		FramebufferFormat DepthFormat = FramebufferFormat::None;
+		// Above 1 renders multisampled, Resolve copies the color attachments to single-sample textures.
+		// Lowered to the highest count every attachment's format supports.
+		uint32_t Samples = 1;
+
+		uint32_t GetColorCount() const;
+		// Same attachments, any size
+		bool IsCompatible(const FramebufferSpec& other) const;
+
+		bool operator==(const FramebufferSpec&) const = default;
+	};
+
+	// A framebuffer and its attachments, owned by FramebufferPool. GL thread only.
+	class RenderTarget
+	{
+	public:
+		RenderTarget(const RenderTarget&) = delete;
+		RenderTarget& operator=(const RenderTarget&) = delete;
+		~RenderTarget();
+
+		const FramebufferSpec& GetSpec() const { return m_Spec; }
+
+		// Draw into this, it's multisampled when the spec asks for it
+		GLuint GetFramebuffer() const { return m_Framebuffer; }
+
+		// Single-sample, valid after Resolve when multisampled
+		Texture GetColorAttachment(uint32_t index = 0) const;
+		// What the framebuffer draws into, multisampled along with it
+		GLuint GetColorBuffer(uint32_t index = 0) const { return m_ColorAttachments[index]; }
+		// Multisampled along with the framebuffer, it's never resolved
+		GLuint GetDepthAttachment() const { return m_DepthAttachment; }
+
+		// Single-sample color attachment 0 with a framebuffer to read it, e.g. for BlitFramebufferToSwapchain
+		Framebuffer GetResolvedFramebuffer() const;
+
+		// Copies the multisampled color attachments into their single-sample textures, no-op without MSAA
+		void Resolve();
+
+		// Every attachment including the resolve textures
+		uint64_t GetMemoryBytes() const;
+	private:
+		RenderTarget() = default;
+
+		void Create(const FramebufferSpec& spec);
+		void Destroy();
+	private:
+		FramebufferSpec m_Spec;
+
+		GLuint m_Framebuffer = 0;
+		GLuint m_ColorAttachments[MaxFramebufferColorAttachments] = {};
+		GLuint m_DepthAttachment = 0;
+
+		// Samples > 1
+		GLuint m_ResolveFramebuffer = 0;
+		GLuint m_ResolvedColorAttachments[MaxFramebufferColorAttachments] = {};
+
+		uint64_t m_LastUsedFrame = 0;
+		bool m_InUse = false;
+
+		friend class FramebufferPool;
+	};
+
+	struct FramebufferPoolStats
+	{
+		uint32_t Targets = 0;
+		uint64_t MemoryBytes = 0;
+		uint64_t Created = 0;
+		uint64_t Resized = 0; // Idle targets reallocated for a new size instead of creating one
+		uint64_t Reused = 0;
+		uint64_t Deleted = 0; // Idle too long
+	};
+
+	// Render targets keyed by spec and kept across frames, so passes can ask for a target every
+	// frame without allocating. Also backs the frame graph's transient textures. GL thread only.
+	class FramebufferPool
+	{
+	public:
+		// An idle target matching spec, else an idle one with the same attachments resized to spec,
+		// else a new one. It's the caller's until Release.
+		static RenderTarget* Acquire(const FramebufferSpec& spec);
+		static void Release(RenderTarget* target);
+
+		// Deletes targets idle for a few frames, Application calls it once per frame
+		static void NextFrame();
+		static void Shutdown();
+
+		// Changes whenever attachments are deleted, GL may hand their names out again so
+		// anything keyed by them, e.g. framebuffers built from them elsewhere, is stale
+		static uint64_t GetGeneration();
+
+		static FramebufferPoolStats GetStats();
+	};
+
+}
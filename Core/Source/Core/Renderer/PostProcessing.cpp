@@ -0,0 +1,241 @@
+#include "PostProcessing.h"
+
+#include "RenderState.h"
+#include "Shader.h"
+#include "ShaderHotReload.h"
+#include "UniformBuffers.h"
+
+#include "Core/Debug/Profiler.h"
+
+#include <algorithm>
+
+namespace Renderer {
+
+	static constexpr const char* BloomDownsamplePath = "Resources/Shaders/BloomDownsample.comp.glsl";
+	static constexpr const char* BloomUpsamplePath = "Resources/Shaders/BloomUpsample.comp.glsl";
+	static constexpr const char* TonemapPath = "Resources/Shaders/Tonemap.comp.glsl";
+	static constexpr const char* FXAAPath = "Resources/Shaders/FXAA.comp.glsl";
+
+	// Local sizes of the shaders
+	static constexpr uint32_t BloomGroupSize = 8;
+	static constexpr uint32_t TonemapGroupSize = 8;
+	static constexpr uint32_t FXAAGroupSize = 16;
+
+	// Levels of the bloom chain, the first at half resolution. The chain also stops before
+	// a level gets smaller than MinBloomSize.
+	static constexpr uint32_t MaxBloomLevels = 6;
+	static constexpr uint32_t MinBloomSize = 8;
+	static constexpr GLenum BloomFormat = GL_R11F_G11F_B10F;
+	static constexpr GLenum OutputFormat = GL_RGBA8;
+
+	// Frame graph names have to outlive the graph
+	static constexpr const char* BloomLevelNames[MaxBloomLevels] = { "Bloom 1", "Bloom 2", "Bloom 3", "Bloom 4", "Bloom 5", "Bloom 6" };
+
+	struct PostProcessingData
+	{
+		// GL thread
+		bool Initialized = false;
+		GLuint BloomDownsampleShader = 0;
+		GLuint BloomUpsampleShader = 0;
+		GLuint TonemapShader = 0;
+		GLuint FXAAShader = 0;
+	};
+
+	static PostProcessingData s_Data;
+
+	static void LoadShader(GLuint& shader, const char* path)
+	{
+		// Failed builds come back as -1
+		shader = CreateComputeShader(path);
+		if (shader == (GLuint)-1)
+			shader = 0;
+
+		WatchComputeShader(&shader, path);
+	}
+
+	static void InitPostProcessing()
+	{
+		PROFILE_FUNC();
+
+		LoadShader(s_Data.BloomDownsampleShader, BloomDownsamplePath);
+		LoadShader(s_Data.BloomUpsampleShader, BloomUpsamplePath);
+		LoadShader(s_Data.TonemapShader, TonemapPath);
+		LoadShader(s_Data.FXAAShader, FXAAPath);
+
+		s_Data.Initialized = true;
+	}
+
+	// Binds shader, false when it failed to build
+	static bool UseShader(const GLuint& shader)
+	{
+		if (!s_Data.Initialized)
+			InitPostProcessing();
+
+		if (!shader)
+			return false;
+
+		RenderState::UseProgram(shader);
+		return true;
+	}
+
+	static void Dispatch(const FrameGraphTextureDesc& output, uint32_t groupSize)
+	{
+		glDispatchCompute((output.Width + groupSize - 1) / groupSize, (output.Height + groupSize - 1) / groupSize, 1);
+	}
+
+	static FrameGraphResource AddBloomPasses(FrameGraph& graph, FrameGraphResource hdrColor, const PostProcessSettings& settings)
+	{
+		FrameGraphResource levels[MaxBloomLevels];
+		uint32_t levelCount = 0;
+
+		FrameGraphTextureDesc desc = graph.GetDesc(hdrColor);
+		desc.Format = BloomFormat;
+		while (levelCount < MaxBloomLevels)
+		{
+			desc.Width = std::max(desc.Width / 2, 1u);
+			desc.Height = std::max(desc.Height / 2, 1u);
+			if (levelCount > 0 && std::min(desc.Width, desc.Height) < MinBloomSize)
+				break;
+
+			levels[levelCount] = graph.CreateTexture(BloomLevelNames[levelCount], desc);
+			levelCount++;
+		}
+
+		for (uint32_t i = 0; i < levelCount; i++)
+		{
+			const FrameGraphResource source = i == 0 ? hdrColor : levels[i - 1];
+			const FrameGraphResource destination = levels[i];
+
+			graph.AddPass("Bloom", [source, destination](FrameGraphBuilder& builder)
+			{
+				builder.Read(source);
+				builder.Write(destination, FrameGraphAccess::Storage);
+			},
+			[source, destination, prefilter = i == 0, threshold = settings.BloomThreshold](const FrameGraphPassResources& resources)
+			{
+				if (!UseShader(s_Data.BloomDownsampleShader))
+					return;
+
+				PostProcessUniforms uniforms;
+				uniforms.BloomThreshold = threshold;
+				uniforms.BloomPrefilter = prefilter ? 1 : 0;
+				SetPostProcessUniforms(uniforms);
+
+				RenderState::BindTextureUnit(0, resources.GetTexture(source));
+				glBindImageTexture(0, resources.GetTexture(destination), 0, GL_FALSE, 0, GL_WRITE_ONLY, BloomFormat);
+
+				Dispatch(resources.GetDesc(destination), BloomGroupSize);
+			});
+		}
+
+		// Each level adds the one below, the first ends up with all of them
+		for (uint32_t i = levelCount - 1; i > 0; i--)
+		{
+			const FrameGraphResource source = levels[i];
+			const FrameGraphResource destination = levels[i - 1];
+
+			graph.AddPass("Bloom", [source, destination](FrameGraphBuilder& builder)
+			{
+				builder.Read(source);
+				builder.Read(destination, FrameGraphAccess::Storage);
+				builder.Write(destination, FrameGraphAccess::Storage);
+			},
+			[source, destination](const FrameGraphPassResources& resources)
+			{
+				if (!UseShader(s_Data.BloomUpsampleShader))
+					return;
+
+				RenderState::BindTextureUnit(0, resources.GetTexture(source));
+				glBindImageTexture(0, resources.GetTexture(destination), 0, GL_FALSE, 0, GL_READ_WRITE, BloomFormat);
+
+				Dispatch(resources.GetDesc(destination), BloomGroupSize);
+			});
+		}
+
+		return levels[0];
+	}
+
+	FrameGraphResource AddPostProcessPasses(FrameGraph& graph, FrameGraphResource hdrColor, const PostProcessSettings& settings)
+	{
+		FrameGraphResource color = hdrColor;
+
+		FrameGraphTextureDesc outputDesc = graph.GetDesc(hdrColor);
+		outputDesc.Format = OutputFormat;
+
+		const FrameGraphResource bloom = settings.Bloom ? AddBloomPasses(graph, hdrColor, settings) : InvalidFrameGraphResource;
+
+		// Also adds the bloom, so it runs for either
+		if (settings.Tonemap || settings.Bloom)
+		{
+			const FrameGraphResource tonemapped = graph.CreateTexture("Tonemapped", outputDesc);
+
+			graph.AddPass("Tonemap", [color, bloom, tonemapped](FrameGraphBuilder& builder)
+			{
+				builder.Read(color);
+				if (bloom != InvalidFrameGraphResource)
+					builder.Read(bloom);
+				builder.Write(tonemapped, FrameGraphAccess::Storage);
+			},
+			[color, bloom, tonemapped, settings](const FrameGraphPassResources& resources)
+			{
+				if (!UseShader(s_Data.TonemapShader))
+					return;
+
+				PostProcessUniforms uniforms;
+				uniforms.Exposure = settings.Exposure;
+				uniforms.BloomIntensity = bloom != InvalidFrameGraphResource ? settings.BloomIntensity : 0.0f;
+				uniforms.Tonemap = settings.Tonemap ? 1 : 0;
+				SetPostProcessUniforms(uniforms);
+
+				const GLuint textures[] = { resources.GetTexture(color), bloom != InvalidFrameGraphResource ? resources.GetTexture(bloom) : 0 };
+				RenderState::BindTextures(0, 2, textures);
+				glBindImageTexture(0, resources.GetTexture(tonemapped), 0, GL_FALSE, 0, GL_WRITE_ONLY, OutputFormat);
+
+				Dispatch(resources.GetDesc(tonemapped), TonemapGroupSize);
+			});
+
+			color = tonemapped;
+		}
+
+		if (settings.FXAA)
+		{
+			const FrameGraphResource antiAliased = graph.CreateTexture("Anti-aliased", outputDesc);
+
+			graph.AddPass("FXAA", [color, antiAliased](FrameGraphBuilder& builder)
+			{
+				builder.Read(color);
+				builder.Write(antiAliased, FrameGraphAccess::Storage);
+			},
+			[color, antiAliased](const FrameGraphPassResources& resources)
+			{
+				if (!UseShader(s_Data.FXAAShader))
+					return;
+
+				RenderState::BindTextureUnit(0, resources.GetTexture(color));
+				glBindImageTexture(0, resources.GetTexture(antiAliased), 0, GL_FALSE, 0, GL_WRITE_ONLY, OutputFormat);
+
+				Dispatch(resources.GetDesc(antiAliased), FXAAGroupSize);
+			});
+
+			color = antiAliased;
+		}
+
+		return color;
+	}
+
+	void ShutdownPostProcessing()
+	{
+		if (!s_Data.Initialized)
+			return;
+
+		for (GLuint* shader : { &s_Data.BloomDownsampleShader, &s_Data.BloomUpsampleShader, &s_Data.TonemapShader, &s_Data.FXAAShader })
+		{
+			UnwatchShader(shader);
+			glDeleteProgram(*shader);
+			*shader = 0;
+		}
+
+		s_Data.Initialized = false;
+	}
+
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "FrameGraph.h"
+
+namespace Renderer {
+
+	struct PostProcessSettings
+	{
+		bool Bloom = true;
+		float BloomThreshold = 1.0f; // Brightness above which pixels bloom
+		float BloomIntensity = 0.15f;
+
+		// ACES filmic curve from HDR to [0, 1], off just clamps
+		bool Tonemap = true;
+		float Exposure = 1.0f;
+
+		bool FXAA = true;
+	};
+
+	// Adds the enabled effects as compute passes over the HDR hdrColor: bloom through a
+	// downsample/upsample chain, tonemapping into RGBA8, then FXAA. Each effect's passes share
+	// its name, so the GPU profiler times each effect. Returns the texture to present, hdrColor
+	// itself when every effect is off.
+	FrameGraphResource AddPostProcessPasses(FrameGraph& graph, FrameGraphResource hdrColor, const PostProcessSettings& settings);
+
+	// GL thread
+	void ShutdownPostProcessing();
+
+}
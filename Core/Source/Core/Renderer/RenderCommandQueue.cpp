@@ -0,0 +1,90 @@
+#include "RenderCommandQueue.h"
+
+#include "Core/Debug/Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace Renderer {
+
+	static constexpr uint32_t BlockSize = 64 * 1024;
+	static constexpr uint32_t CommandAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+	struct CommandHeader
+	{
+		RenderCommandQueue::RenderCommandFn Function;
+		uint32_t Size; // Payload size, excluding this header
+	};
+
+	static constexpr uint32_t AlignUp(uint32_t value, uint32_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	static constexpr uint32_t HeaderSize = AlignUp(sizeof(CommandHeader), CommandAlignment);
+
+	void* RenderCommandQueue::Allocate(RenderCommandFn func, uint32_t size)
+	{
+		const uint32_t commandSize = HeaderSize + AlignUp(size, CommandAlignment);
+
+		std::scoped_lock lock(m_Mutex);
+
+		while (m_ActiveBlock < m_Blocks.size() && m_Blocks[m_ActiveBlock].Size + commandSize > m_Blocks[m_ActiveBlock].Capacity)
+			m_ActiveBlock++;
+
+		if (m_ActiveBlock == m_Blocks.size())
+		{
+			Block& block = m_Blocks.emplace_back();
+			block.Capacity = std::max(BlockSize, commandSize);
+			block.Data = std::make_unique<uint8_t[]>(block.Capacity);
+		}
+
+		Block& block = m_Blocks[m_ActiveBlock];
+		uint8_t* command = block.Data.get() + block.Size;
+		block.Size += commandSize;
+		m_CommandCount++;
+
+		*(CommandHeader*)command = { func, size };
+		return command + HeaderSize;
+	}
+
+	void RenderCommandQueue::Execute()
+	{
+		PROFILE_FUNC();
+
+		for (Block& block : m_Blocks)
+		{
+			uint32_t offset = 0;
+			while (offset < block.Size)
+			{
+				const CommandHeader header = *(CommandHeader*)(block.Data.get() + offset);
+				header.Function(block.Data.get() + offset + HeaderSize);
+				offset += HeaderSize + AlignUp(header.Size, CommandAlignment);
+			}
+
+			block.Size = 0;
+		}
+
+		m_ActiveBlock = 0;
+		m_CommandCount = 0;
+	}
+
+	static RenderCommandQueue s_CommandQueues[2];
+	static std::atomic<uint32_t> s_SubmitQueueIndex = 0;
+
+	RenderCommandQueue& GetSubmitQueue()
+	{
+		return s_CommandQueues[s_SubmitQueueIndex.load(std::memory_order_relaxed)];
+	}
+
+	void SwapQueues()
+	{
+		s_SubmitQueueIndex.store(1 - s_SubmitQueueIndex.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+
+	void ExecuteRenderQueue()
+	{
+		s_CommandQueues[1 - s_SubmitQueueIndex.load(std::memory_order_relaxed)].Execute();
+	}
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdint.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Renderer {
+
+	// Linear buffer of type-erased render commands. Storage is kept in fixed-size
+	// blocks that are reused frame to frame, so recorded commands never move.
+	class RenderCommandQueue
+	{
+	public:
+		using RenderCommandFn = void(*)(void*);
+
+		RenderCommandQueue() = default;
+
+		RenderCommandQueue(const RenderCommandQueue&) = delete;
+		RenderCommandQueue& operator=(const RenderCommandQueue&) = delete;
+
+		// Returns storage for a command payload of the given size. Safe to call from several threads.
+		void* Allocate(RenderCommandFn func, uint32_t size);
+
+		// Runs and destroys every recorded command in submission order, then resets the queue
+		void Execute();
+
+		uint32_t GetCommandCount() const { return m_CommandCount; }
+	private:
+		struct Block
+		{
+			std::unique_ptr<uint8_t[]> Data;
+			uint32_t Capacity = 0;
+			uint32_t Size = 0;
+		};
+
+		std::vector<Block> m_Blocks;
+		uint32_t m_ActiveBlock = 0;
+		uint32_t m_CommandCount = 0;
+		std::mutex m_Mutex;
+	};
+
+	// The main thread records into the submit queue while the render thread (or the
+	// main thread itself, when no render thread is running) executes the other one.
+	RenderCommandQueue& GetSubmitQueue();
+	void SwapQueues();
+	void ExecuteRenderQueue();
+
+	// Records func to run on whichever thread owns the GL context, in submission order.
+	// Anything read from the layer at record time should be captured by value.
+	template<typename FuncT>
+	void Submit(FuncT&& func)
+	{
+		using Command = std::decay_t<FuncT>;
+
+		auto renderCommand = [](void* ptr)
+		{
+			Command* command = (Command*)ptr;
+			(*command)();
+			command->~Command();
+		};
+
+		static_assert(alignof(Command) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Render command is over-aligned");
+
+		void* storage = GetSubmitQueue().Allocate(renderCommand, sizeof(Command));
+		new (storage) Command(std::forward<FuncT>(func));
+	}
+
+}
@@ -0,0 +1,224 @@
+#include "RenderState.h"
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+
+namespace Renderer {
+
+	// Units shadowed by BindTextureUnit/BindTextures, higher ones always reach GL
+	static constexpr GLuint MaxTextureUnits = 32;
+
+	struct RenderStateData
+	{
+		// Empty when unknown
+		std::optional<GLuint> Program;
+		std::optional<GLuint> VertexArray;
+		std::optional<GLuint> DrawFramebuffer;
+		std::optional<GLuint> ReadFramebuffer;
+		std::optional<glm::ivec4> Viewport;
+		std::optional<bool> Blend;
+		std::optional<glm::uvec2> BlendFunc;
+		std::optional<bool> DepthTest;
+		std::optional<bool> DepthWrite;
+		std::optional<GLenum> DepthFunc;
+		std::optional<glm::vec4> ClearColor;
+		std::optional<GLuint> TextureUnits[MaxTextureUnits];
+
+		RenderStateStats Stats;
+
+		std::mutex LastFrameMutex;
+		RenderStateStats LastFrame;
+	};
+
+	static RenderStateData s_Data;
+
+	// Records value and returns true when the GL call is needed
+	template<typename T>
+	static bool Update(std::optional<T>& shadow, const T& value)
+	{
+		if (shadow && *shadow == value)
+		{
+			s_Data.Stats.Redundant++;
+			return false;
+		}
+
+		shadow = value;
+		s_Data.Stats.Calls++;
+		return true;
+	}
+
+	static void SetCapability(std::optional<bool>& shadow, GLenum capability, bool enabled)
+	{
+		if (!Update(shadow, enabled))
+			return;
+
+		if (enabled)
+			glEnable(capability);
+		else
+			glDisable(capability);
+	}
+
+	void RenderState::UseProgram(GLuint program)
+	{
+		if (Update(s_Data.Program, program))
+			glUseProgram(program);
+	}
+
+	void RenderState::BindVertexArray(GLuint vertexArray)
+	{
+		if (Update(s_Data.VertexArray, vertexArray))
+			glBindVertexArray(vertexArray);
+	}
+
+	void RenderState::BindFramebuffer(GLenum target, GLuint framebuffer)
+	{
+		switch (target)
+		{
+		case GL_DRAW_FRAMEBUFFER:
+			if (Update(s_Data.DrawFramebuffer, framebuffer))
+				glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+			break;
+		case GL_READ_FRAMEBUFFER:
+			if (Update(s_Data.ReadFramebuffer, framebuffer))
+				glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+			break;
+		default:
+			if (s_Data.DrawFramebuffer == framebuffer && s_Data.ReadFramebuffer == framebuffer)
+			{
+				s_Data.Stats.Redundant++;
+				break;
+			}
+
+			s_Data.DrawFramebuffer = framebuffer;
+			s_Data.ReadFramebuffer = framebuffer;
+			s_Data.Stats.Calls++;
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+			break;
+		}
+	}
+
+	void RenderState::SetViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+	{
+		if (Update(s_Data.Viewport, glm::ivec4(x, y, width, height)))
+			glViewport(x, y, width, height);
+	}
+
+	void RenderState::SetBlend(bool enabled)
+	{
+		SetCapability(s_Data.Blend, GL_BLEND, enabled);
+	}
+
+	void RenderState::SetBlendFunc(GLenum source, GLenum destination)
+	{
+		if (Update(s_Data.BlendFunc, glm::uvec2(source, destination)))
+			glBlendFunc(source, destination);
+	}
+
+	void RenderState::SetDepthTest(bool enabled)
+	{
+		SetCapability(s_Data.DepthTest, GL_DEPTH_TEST, enabled);
+	}
+
+	void RenderState::SetDepthWrite(bool enabled)
+	{
+		if (Update(s_Data.DepthWrite, enabled))
+			glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+	}
+
+	void RenderState::SetDepthFunc(GLenum func)
+	{
+		if (Update(s_Data.DepthFunc, func))
+			glDepthFunc(func);
+	}
+
+	void RenderState::SetClearColor(const glm::vec4& color)
+	{
+		if (Update(s_Data.ClearColor, color))
+			glClearColor(color.r, color.g, color.b, color.a);
+	}
+
+	void RenderState::BindTextureUnit(GLuint unit, GLuint texture)
+	{
+		if (unit >= MaxTextureUnits)
+		{
+			s_Data.Stats.Calls++;
+			glBindTextureUnit(unit, texture);
+			return;
+		}
+
+		if (Update(s_Data.TextureUnits[unit], texture))
+			glBindTextureUnit(unit, texture);
+	}
+
+	void RenderState::BindTextures(GLuint first, GLsizei count, const GLuint* textures)
+	{
+		if (first + count > MaxTextureUnits)
+		{
+			for (GLuint unit = first; unit < MaxTextureUnits; unit++)
+				s_Data.TextureUnits[unit].reset();
+
+			s_Data.Stats.Calls++;
+			glBindTextures(first, count, textures);
+			return;
+		}
+
+		// Narrow the call down to the units that change, a null textures unbinds them all
+		GLsizei begin = count, end = 0;
+		for (GLsizei i = 0; i < count; i++)
+		{
+			const GLuint texture = textures ? textures[i] : 0;
+			std::optional<GLuint>& shadow = s_Data.TextureUnits[first + i];
+			if (shadow == texture)
+				continue;
+
+			shadow = texture;
+			begin = std::min(begin, i);
+			end = i + 1;
+		}
+
+		if (begin >= end)
+		{
+			s_Data.Stats.Redundant++;
+			return;
+		}
+
+		s_Data.Stats.Calls++;
+		glBindTextures(first + begin, end - begin, textures ? textures + begin : nullptr);
+	}
+
+	void RenderState::Invalidate()
+	{
+		s_Data.Program.reset();
+		s_Data.VertexArray.reset();
+		s_Data.DrawFramebuffer.reset();
+		s_Data.ReadFramebuffer.reset();
+		s_Data.Viewport.reset();
+		s_Data.Blend.reset();
+		s_Data.BlendFunc.reset();
+		s_Data.DepthTest.reset();
+		s_Data.DepthWrite.reset();
+		s_Data.DepthFunc.reset();
+		s_Data.ClearColor.reset();
+		for (std::optional<GLuint>& unit : s_Data.TextureUnits)
+			unit.reset();
+	}
+
+	void RenderState::BeginFrame()
+	{
+		{
+			std::scoped_lock lock(s_Data.LastFrameMutex);
+			s_Data.LastFrame = s_Data.Stats;
+		}
+		s_Data.Stats = {};
+
+		Invalidate();
+	}
+
+	RenderStateStats RenderState::GetLastFrameStats()
+	{
+		std::scoped_lock lock(s_Data.LastFrameMutex);
+		return s_Data.LastFrame;
+	}
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <stdint.h>
+
+namespace Renderer {
+
+	struct RenderStateStats
+	{
+		uint32_t Calls = 0;     // State changes passed on to GL
+		uint32_t Redundant = 0; // Dropped because GL already had that state
+	};
+
+	// Shadows the GL state the renderer touches and drops calls that wouldn't change it, so
+	// every draw can set all the state it needs without paying for it. Code that changes this
+	// state behind its back, or deletes a bound object, has to call Invalidate. GL thread only.
+	class RenderState
+	{
+	public:
+		static void UseProgram(GLuint program);
+		static void BindVertexArray(GLuint vertexArray);
+		// GL_FRAMEBUFFER binds both the draw and the read framebuffer
+		static void BindFramebuffer(GLenum target, GLuint framebuffer);
+		static void SetViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+		static void SetBlend(bool enabled);
+		static void SetBlendFunc(GLenum source, GLenum destination);
+		static void SetDepthTest(bool enabled);
+		static void SetDepthWrite(bool enabled);
+		static void SetDepthFunc(GLenum func);
+		static void SetClearColor(const glm::vec4& color);
+
+		static void BindTextureUnit(GLuint unit, GLuint texture);
+		// Only the changed range of units is rebound
+		static void BindTextures(GLuint first, GLsizei count, const GLuint* textures);
+
+		// Forgets everything, the next call of each kind always reaches GL
+		static void Invalidate();
+
+		// Application calls this before the layers render: publishes the counts since the
+		// previous call and invalidates, objects may have been deleted in between
+		static void BeginFrame();
+
+		// Any thread, the counts for the last complete frame
+		static RenderStateStats GetLastFrameStats();
+	};
+
+}
@@ -1,7 +1,9 @@
 #include "Renderer.h"
 
 #include "GLUtils.h"
+#include "RenderState.h"
 
+#include "Core/Debug/GPUProfiler.h"
 #include "Core/Debug/Profiler.h"
 
 #include <iostream>
@@ -12,7 +14,9 @@
 
 namespace Renderer {
 
-	Texture CreateTexture(int width, int height)
+	static GLuint s_Backbuffer = 0;
+
+	Texture CreateTexture(int width, int height, GLenum format)
 	{
 		PROFILE_FUNC();
 
@@ -22,7 +26,7 @@ namespace Renderer {
 
 		glCreateTextures(GL_TEXTURE_2D, 1, &result.Handle);
 
-		glTextureStorage2D(result.Handle, 1, GL_RGBA32F, width, height);
+		glTextureStorage2D(result.Handle, 1, format, width, height);
 
 		glTextureParameteri(result.Handle, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 		glTextureParameteri(result.Handle, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -110,23 +114,74 @@ namespace Renderer {
 	void BlitFramebufferToSwapchain(const Framebuffer framebuffer)
 	{
 		PROFILE_FUNC();
+		PROFILE_GPU_SCOPE("Blit To Swapchain");
 
-		glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer.Handle);
-		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0); // swapchain
+		RenderState::BindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer.Handle);
+		RenderState::BindFramebuffer(GL_DRAW_FRAMEBUFFER, s_Backbuffer); // swapchain
 
 		glBlitFramebuffer(0, 0, framebuffer.ColorAttachment.Width, framebuffer.ColorAttachment.Height, // Source rect
 			0, 0, framebuffer.ColorAttachment.Width, framebuffer.ColorAttachment.Height,               // Destination rect
 			GL_COLOR_BUFFER_BIT, GL_NEAREST);
 	}
 
-	void Renderer::BeginFrame(int w, int h)
+	void BeginFrame(int w, int h)
 	{
 		PROFILE_FUNC();
+		PROFILE_GPU_SCOPE("Begin Frame");
 
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
-		glViewport(0, 0, w, h);
-		glClearColor(0.05f, 0.05f, 0.05f, 1.0f);
+		RenderState::BindFramebuffer(GL_FRAMEBUFFER, s_Backbuffer);
+		RenderState::SetViewport(0, 0, w, h);
+		RenderState::SetClearColor({ 0.05f, 0.05f, 0.05f, 1.0f });
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 	}
 
-}
+	uint32_t GetBytesPerPixel(GLenum format)
+	{
+		switch (format)
+		{
+		case GL_R8:                return 1;
+		case GL_RG8:
+		case GL_R16F:
+		case GL_DEPTH_COMPONENT16: return 2;
+		case GL_RGBA8:
+		case GL_SRGB8_ALPHA8:
+		case GL_RGB10_A2:
+		case GL_R11F_G11F_B10F:
+		case GL_RG16F:
+		case GL_R32F:
+		case GL_DEPTH_COMPONENT24:
+		case GL_DEPTH_COMPONENT32F:
+		case GL_DEPTH24_STENCIL8:  return 4;
+		case GL_RGBA16F:
+		case GL_RG32F:
+		case GL_DEPTH32F_STENCIL8: return 8;
+		case GL_RGBA32F:           return 16;
+		}
+		return 4;
+	}
+
+	bool IsDepthFormat(GLenum format)
+	{
+		switch (format)
+		{
+		case GL_DEPTH_COMPONENT16:
+		case GL_DEPTH_COMPONENT24:
+		case GL_DEPTH_COMPONENT32F:
+		case GL_DEPTH24_STENCIL8:
+		case GL_DEPTH32F_STENCIL8:
+			return true;
+		}
+		return false;
+	}
+
+	GLuint GetBackbuffer()
+	{
+		return s_Backbuffer;
+	}
+
+	void SetBackbuffer(GLuint framebuffer)
+	{
+		s_Backbuffer = framebuffer;
+	}
+
+}
\ No newline at end of file
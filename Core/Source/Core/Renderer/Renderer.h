@@ -20,10 +20,19 @@ namespace Renderer {
 		Texture ColorAttachment;
 	};
 
-	Texture CreateTexture(int width, int height);
+	Texture CreateTexture(int width, int height, GLenum format = GL_RGBA8);
 	Texture LoadTexture(const std::filesystem::path& path);
 	Framebuffer CreateFramebufferWithTexture(const Texture texture);
 	bool AttachTextureToFramebuffer(Framebuffer& framebuffer, const Texture texture);
 	void BlitFramebufferToSwapchain(const Framebuffer framebuffer);
 	void BeginFrame(int w, int h);
+
+	// For the sized internal formats used by render targets
+	uint32_t GetBytesPerPixel(GLenum format);
+	bool IsDepthFormat(GLenum format);
+
+	// Stands in for the window's default framebuffer: 0, or an offscreen framebuffer when
+	// the application runs headless. Bind this instead of 0 when drawing to the screen.
+	GLuint GetBackbuffer();
+	void SetBackbuffer(GLuint framebuffer);
 }
\ No newline at end of file
@@ -0,0 +1,341 @@
+#include "Renderer2D.h"
+
+#include "RenderState.h"
+#include "Shader.h"
+#include "ShaderHotReload.h"
+#include "StreamingBuffer.h"
+#include "UniformBuffers.h"
+
+#include "Core/FrameAllocator.h"
+#include "Core/Debug/Profiler.h"
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <assert.h>
+#include <cstring>
+#include <new>
+
+namespace Renderer {
+
+	// Size of u_Textures in Renderer2D.frag.glsl
+	static constexpr uint32_t MaxTextureSlots = 32;
+
+	static constexpr const char* VertexShaderPath = "Resources/Shaders/Renderer2D.vert.glsl";
+	static constexpr const char* FragmentShaderPath = "Resources/Shaders/Renderer2D.frag.glsl";
+
+	// A scene's instance pages start this small and double up to the max, so scenes of a few
+	// quads take little arena and large ones few pages
+	static constexpr uint32_t MinPageInstances = 32;
+	static constexpr uint32_t MaxPageInstances = 16384;
+
+	// Vertex attributes with a divisor of 1, the corners come from gl_VertexID
+	struct QuadInstance
+	{
+		glm::vec4 Basis;       // Transformed x axis in xy, y axis in zw
+		glm::vec2 Translation;
+		uint32_t Tint;         // RGBA8
+		uint32_t TextureIndex; // Into the batch's texture slots
+		glm::vec4 UVRect;
+	};
+	static_assert(sizeof(QuadInstance) == 48);
+
+	struct QuadBatch
+	{
+		QuadBatch* Next = nullptr;
+		uint32_t FirstInstance = 0;
+		uint32_t InstanceCount = 0;
+		uint32_t TextureCount = 0;
+		GLuint Textures[MaxTextureSlots]; // 0 stands for the white texture
+	};
+
+	struct InstancePage
+	{
+		InstancePage* Next = nullptr;
+		QuadInstance* Instances = nullptr;
+		uint32_t Count = 0;
+		uint32_t Capacity = 0;
+	};
+
+	// Everything a scene records comes from the FrameAllocator, which keeps it alive until
+	// the GL thread has drawn the frame
+	struct Scene2D
+	{
+		glm::mat4 ViewProjection;
+		InstancePage* FirstPage = nullptr;
+		InstancePage* LastPage = nullptr;
+		QuadBatch* FirstBatch = nullptr;
+		QuadBatch* LastBatch = nullptr;
+		uint32_t InstanceCount = 0;
+	};
+
+	struct Renderer2DData
+	{
+		// Main thread
+		Scene2D* CurrentScene = nullptr;
+		Renderer2DStats Stats;
+
+		// GL thread
+		bool Initialized = false;
+		GLuint Shader = 0;
+		GLuint VertexArray = 0;
+		GLuint InstanceBuffer = 0;
+		GLuint WhiteTexture = 0;
+		size_t InstanceBufferCapacity = 0;
+	};
+
+	static Renderer2DData s_Data;
+
+	static void InitRenderer2D()
+	{
+		PROFILE_FUNC();
+
+		// Failed builds come back as -1
+		s_Data.Shader = CreateGraphicsShader(VertexShaderPath, FragmentShaderPath);
+		if (s_Data.Shader == (GLuint)-1)
+			s_Data.Shader = 0;
+
+		WatchGraphicsShader(&s_Data.Shader, VertexShaderPath, FragmentShaderPath);
+
+		glCreateBuffers(1, &s_Data.InstanceBuffer);
+
+		// The instance data's buffer is bound per scene
+		glCreateVertexArrays(1, &s_Data.VertexArray);
+		glVertexArrayBindingDivisor(s_Data.VertexArray, 0, 1);
+
+		for (GLuint attribute = 0; attribute < 5; attribute++)
+		{
+			glEnableVertexArrayAttrib(s_Data.VertexArray, attribute);
+			glVertexArrayAttribBinding(s_Data.VertexArray, attribute, 0);
+		}
+
+		glVertexArrayAttribFormat(s_Data.VertexArray, 0, 4, GL_FLOAT, GL_FALSE, offsetof(QuadInstance, Basis));
+		glVertexArrayAttribFormat(s_Data.VertexArray, 1, 2, GL_FLOAT, GL_FALSE, offsetof(QuadInstance, Translation));
+		glVertexArrayAttribFormat(s_Data.VertexArray, 2, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(QuadInstance, Tint));
+		glVertexArrayAttribIFormat(s_Data.VertexArray, 3, 1, GL_UNSIGNED_INT, offsetof(QuadInstance, TextureIndex));
+		glVertexArrayAttribFormat(s_Data.VertexArray, 4, 4, GL_FLOAT, GL_FALSE, offsetof(QuadInstance, UVRect));
+
+		const uint32_t white = 0xffffffff;
+		glCreateTextures(GL_TEXTURE_2D, 1, &s_Data.WhiteTexture);
+		glTextureStorage2D(s_Data.WhiteTexture, 1, GL_RGBA8, 1, 1);
+		glTextureSubImage2D(s_Data.WhiteTexture, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, &white);
+
+		s_Data.Initialized = true;
+	}
+
+	static void DrawScene(const Scene2D& scene, GLuint framebuffer, uint32_t width, uint32_t height)
+	{
+		PROFILE_FUNC();
+
+		if (!s_Data.Initialized)
+			InitRenderer2D();
+
+		if (!s_Data.Shader)
+			return;
+
+		const size_t size = scene.InstanceCount * sizeof(QuadInstance);
+
+		// Written straight into this frame's region of the streaming buffer when it fits
+		if (StreamingAllocation allocation = GetStreamingBuffer().Allocate(size))
+		{
+			uint8_t* destination = (uint8_t*)allocation.Data;
+			for (const InstancePage* page = scene.FirstPage; page; page = page->Next)
+			{
+				std::memcpy(destination, page->Instances, page->Count * sizeof(QuadInstance));
+				destination += page->Count * sizeof(QuadInstance);
+			}
+			glVertexArrayVertexBuffer(s_Data.VertexArray, 0, allocation.Buffer, allocation.Offset, sizeof(QuadInstance));
+		}
+		else
+		{
+			if (size > s_Data.InstanceBufferCapacity)
+			{
+				s_Data.InstanceBufferCapacity = std::max(size, s_Data.InstanceBufferCapacity * 2);
+				glNamedBufferData(s_Data.InstanceBuffer, s_Data.InstanceBufferCapacity, nullptr, GL_STREAM_DRAW);
+			}
+			else
+			{
+				// Lets the driver hand out fresh storage instead of waiting on the previous draws
+				glInvalidateBufferData(s_Data.InstanceBuffer);
+			}
+
+			GLintptr offset = 0;
+			for (const InstancePage* page = scene.FirstPage; page; page = page->Next)
+			{
+				glNamedBufferSubData(s_Data.InstanceBuffer, offset, page->Count * sizeof(QuadInstance), page->Instances);
+				offset += page->Count * sizeof(QuadInstance);
+			}
+			glVertexArrayVertexBuffer(s_Data.VertexArray, 0, s_Data.InstanceBuffer, 0, sizeof(QuadInstance));
+		}
+
+		ViewUniforms view;
+		view.Projection = scene.ViewProjection;
+		view.ViewProjection = scene.ViewProjection;
+		SetViewUniforms(view);
+
+		RenderState::BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		RenderState::SetViewport(0, 0, width, height);
+		RenderState::SetBlend(true);
+		RenderState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		RenderState::SetDepthTest(false);
+
+		RenderState::UseProgram(s_Data.Shader);
+		RenderState::BindVertexArray(s_Data.VertexArray);
+
+		for (const QuadBatch* batch = scene.FirstBatch; batch; batch = batch->Next)
+		{
+			if (batch->InstanceCount == 0)
+				continue;
+
+			GLuint textures[MaxTextureSlots];
+			for (uint32_t i = 0; i < batch->TextureCount; i++)
+				textures[i] = batch->Textures[i] ? batch->Textures[i] : s_Data.WhiteTexture;
+
+			RenderState::BindTextures(0, batch->TextureCount, textures);
+			glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, batch->InstanceCount, batch->FirstInstance);
+		}
+	}
+
+	static QuadBatch* AddBatch(Scene2D& scene)
+	{
+		QuadBatch* batch = Core::FrameAllocator::New<QuadBatch>();
+		batch->FirstInstance = scene.InstanceCount;
+
+		if (scene.LastBatch)
+			scene.LastBatch->Next = batch;
+		else
+			scene.FirstBatch = batch;
+		scene.LastBatch = batch;
+
+		return batch;
+	}
+
+	static uint32_t GetTextureSlot(Scene2D& scene, GLuint texture)
+	{
+		QuadBatch* batch = scene.LastBatch;
+
+		for (uint32_t i = 0; i < batch->TextureCount; i++)
+		{
+			if (batch->Textures[i] == texture)
+				return i;
+		}
+
+		if (batch->TextureCount == MaxTextureSlots)
+			batch = AddBatch(scene);
+
+		batch->Textures[batch->TextureCount] = texture;
+		return batch->TextureCount++;
+	}
+
+	static QuadInstance* AllocateInstance(Scene2D& scene)
+	{
+		InstancePage* page = scene.LastPage;
+		if (!page || page->Count == page->Capacity)
+		{
+			InstancePage* next = Core::FrameAllocator::New<InstancePage>();
+			next->Capacity = page ? std::min(page->Capacity * 2, MaxPageInstances) : MinPageInstances;
+			next->Instances = (QuadInstance*)Core::FrameAllocator::Allocate(next->Capacity * sizeof(QuadInstance), alignof(QuadInstance));
+
+			if (page)
+				page->Next = next;
+			else
+				scene.FirstPage = next;
+			scene.LastPage = page = next;
+		}
+
+		scene.InstanceCount++;
+		return &page->Instances[page->Count++];
+	}
+
+	static void AddQuad(const glm::vec4& basis, const glm::vec2& translation, GLuint texture, const glm::vec4& tint, const glm::vec4& uvRect)
+	{
+		assert(s_Data.CurrentScene && "DrawQuad outside of BeginScene2D/EndScene2D");
+
+		Scene2D& scene = *s_Data.CurrentScene;
+
+		const uint32_t textureIndex = GetTextureSlot(scene, texture);
+		new (AllocateInstance(scene)) QuadInstance{ basis, translation, glm::packUnorm4x8(tint), textureIndex, uvRect };
+		scene.LastBatch->InstanceCount++;
+	}
+
+	void BeginScene2D(const glm::mat4& viewProjection)
+	{
+		assert(!s_Data.CurrentScene && "BeginScene2D called twice");
+
+		Scene2D* scene = Core::FrameAllocator::New<Scene2D>();
+		scene->ViewProjection = viewProjection;
+		AddBatch(*scene);
+
+		s_Data.CurrentScene = scene;
+	}
+
+	void EndScene2D(FrameGraph& graph, FrameGraphResource target)
+	{
+		PROFILE_FUNC();
+
+		assert(s_Data.CurrentScene && "EndScene2D without BeginScene2D");
+
+		Scene2D* scene = s_Data.CurrentScene;
+		s_Data.CurrentScene = nullptr;
+
+		s_Data.Stats.Scenes++;
+		s_Data.Stats.Quads += scene->InstanceCount;
+		for (const QuadBatch* batch = scene->FirstBatch; batch; batch = batch->Next)
+			s_Data.Stats.DrawCalls += batch->InstanceCount > 0;
+
+		if (scene->InstanceCount == 0)
+			return;
+
+		graph.AddPass("Renderer2D", [target](FrameGraphBuilder& builder)
+		{
+			builder.Read(target, FrameGraphAccess::ColorAttachment);
+			builder.Write(target);
+		},
+		[scene, target](const FrameGraphPassResources& resources)
+		{
+			const FrameGraphTextureDesc& desc = resources.GetDesc(target);
+			DrawScene(*scene, resources.GetFramebuffer(), desc.Width, desc.Height);
+		});
+	}
+
+	void DrawQuad(const glm::mat4& transform, GLuint texture, const glm::vec4& tint, const glm::vec4& uvRect)
+	{
+		AddQuad({ transform[0][0], transform[0][1], transform[1][0], transform[1][1] }, { transform[3][0], transform[3][1] }, texture, tint, uvRect);
+	}
+
+	void DrawQuad(const glm::vec2& position, const glm::vec2& size, GLuint texture, const glm::vec4& tint)
+	{
+		AddQuad({ size.x, 0.0f, 0.0f, size.y }, position, texture, tint, { 0.0f, 0.0f, 1.0f, 1.0f });
+	}
+
+	void ShutdownRenderer2D()
+	{
+		if (!s_Data.Initialized)
+			return;
+
+		UnwatchShader(&s_Data.Shader);
+
+		glDeleteProgram(s_Data.Shader);
+		glDeleteVertexArrays(1, &s_Data.VertexArray);
+		glDeleteBuffers(1, &s_Data.InstanceBuffer);
+		glDeleteTextures(1, &s_Data.WhiteTexture);
+
+		s_Data.Shader = 0;
+		s_Data.VertexArray = 0;
+		s_Data.InstanceBuffer = 0;
+		s_Data.WhiteTexture = 0;
+		s_Data.InstanceBufferCapacity = 0;
+		s_Data.Initialized = false;
+	}
+
+	Renderer2DStats GetRenderer2DStats()
+	{
+		return s_Data.Stats;
+	}
+
+	void ResetRenderer2DStats()
+	{
+		s_Data.Stats = {};
+	}
+
+}
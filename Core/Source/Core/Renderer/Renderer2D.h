@@ -0,0 +1,37 @@
+#pragma once
+
+#include "FrameGraph.h"
+#include "Renderer.h"
+
+#include <glm/glm.hpp>
+
+namespace Renderer {
+
+	struct Renderer2DStats
+	{
+		uint32_t Quads = 0;
+		uint32_t DrawCalls = 0; // One instanced draw per batch
+		uint32_t Scenes = 0;
+	};
+
+	// Batches quads into an instance buffer and draws them with one instanced draw per
+	// batch, a batch ending when it would need more than 32 textures. Main thread: quads are
+	// recorded between BeginScene2D and EndScene2D, which adds a pass to graph that blends them
+	// onto target. The pass sets the view block to viewProjection. Recorded quads live in the
+	// FrameAllocator.
+	void BeginScene2D(const glm::mat4& viewProjection);
+	void EndScene2D(FrameGraph& graph, FrameGraphResource target);
+
+	// The unit quad [-0.5, 0.5]^2 under transform. Only the 2D part of transform is used.
+	// texture 0 draws the tint as a solid color. uvRect is min uv in xy, max uv in zw.
+	void DrawQuad(const glm::mat4& transform, GLuint texture = 0, const glm::vec4& tint = glm::vec4(1.0f), const glm::vec4& uvRect = { 0.0f, 0.0f, 1.0f, 1.0f });
+	void DrawQuad(const glm::vec2& position, const glm::vec2& size, GLuint texture = 0, const glm::vec4& tint = glm::vec4(1.0f));
+
+	// GL thread
+	void ShutdownRenderer2D();
+
+	// Accumulated since the last reset, Application resets them at the start of every frame
+	Renderer2DStats GetRenderer2DStats();
+	void ResetRenderer2DStats();
+
+}
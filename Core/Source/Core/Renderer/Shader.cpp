@@ -1,36 +1,35 @@
 #include "Shader.h"
 
+#include "ShaderCache.h"
+#include "ShaderPreprocessor.h"
+
 #include "Core/Debug/Profiler.h"
 
+#include <chrono>
 #include <iostream>
-#include <fstream>
+#include <vector>
 
 #include <glad/glad.h>
 
 namespace Renderer {
 
-	static std::string ReadTextFile(const std::filesystem::path& path)
+	std::string LoadShaderSource(const std::filesystem::path& path)
 	{
-		PROFILE_FUNC();
-
-		std::ifstream file(path);
-
-		if (!file.is_open())
-		{
-			std::cerr << "Failed to open file: " << path.string() << std::endl;
-			return {};
-		}
-
-		std::ostringstream contentStream;
-		contentStream << file.rdbuf();
-		return contentStream.str();
+		return PreprocessShader(path)->Source;
 	}
 
 	uint32_t CreateComputeShader(const std::filesystem::path& path)
 	{
 		PROFILE_FUNC();
 
-		std::string shaderSource = ReadTextFile(path);
+		auto shader = PreprocessShader(path);
+		const std::string& shaderSource = shader->Source;
+
+		uint64_t cacheKey = ComputeShaderCacheKey({ shaderSource });
+		if (GLuint cachedProgram = LoadCachedProgram(cacheKey))
+			return cachedProgram;
+
+		auto compileStart = std::chrono::steady_clock::now();
 
 		GLuint shaderHandle = glCreateShader(GL_COMPUTE_SHADER);
 
@@ -49,7 +48,7 @@ namespace Renderer {
 			std::vector<GLchar> infoLog(maxLength);
 			glGetShaderInfoLog(shaderHandle, maxLength, &maxLength, &infoLog[0]);
 
-			std::cerr << infoLog.data() << std::endl;
+			std::cerr << "Source strings: " << DescribeShaderSourceStrings(*shader) << "\n" << infoLog.data() << std::endl;
 
 			glDeleteShader(shaderHandle);
 			return -1;
@@ -57,6 +56,7 @@ namespace Renderer {
 
 		GLuint program = glCreateProgram();
 		glAttachShader(program, shaderHandle);
+		PrepareProgramForCache(program);
 		glLinkProgram(program);
 
 		GLint isLinked = 0;
@@ -78,6 +78,9 @@ namespace Renderer {
 		}
 
 		glDetachShader(program, shaderHandle);
+		glDeleteShader(shaderHandle);
+
+		StoreCachedProgram(cacheKey, program, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - compileStart).count());
 		return program;
 	}
 
@@ -99,8 +102,16 @@ namespace Renderer {
 	{
 		PROFILE_FUNC();
 
-		std::string vertexShaderSource = ReadTextFile(vertexPath);
-		std::string fragmentShaderSource = ReadTextFile(fragmentPath);
+		auto vertexShader = PreprocessShader(vertexPath);
+		auto fragmentShader = PreprocessShader(fragmentPath);
+		const std::string& vertexShaderSource = vertexShader->Source;
+		const std::string& fragmentShaderSource = fragmentShader->Source;
+
+		uint64_t cacheKey = ComputeShaderCacheKey({ vertexShaderSource, fragmentShaderSource });
+		if (GLuint cachedProgram = LoadCachedProgram(cacheKey))
+			return cachedProgram;
+
+		auto compileStart = std::chrono::steady_clock::now();
 
 		// Vertex shader
 
@@ -121,7 +132,7 @@ namespace Renderer {
 			std::vector<GLchar> infoLog(maxLength);
 			glGetShaderInfoLog(vertexShaderHandle, maxLength, &maxLength, &infoLog[0]);
 
-			std::cerr << infoLog.data() << std::endl;
+			std::cerr << "Source strings: " << DescribeShaderSourceStrings(*vertexShader) << "\n" << infoLog.data() << std::endl;
 
 			glDeleteShader(vertexShaderHandle);
 			return -1;
@@ -146,7 +157,7 @@ namespace Renderer {
 			std::vector<GLchar> infoLog(maxLength);
 			glGetShaderInfoLog(fragmentShaderHandle, maxLength, &maxLength, &infoLog[0]);
 
-			std::cerr << infoLog.data() << std::endl;
+			std::cerr << "Source strings: " << DescribeShaderSourceStrings(*fragmentShader) << "\n" << infoLog.data() << std::endl;
 
 			glDeleteShader(fragmentShaderHandle);
 			return -1;
@@ -157,6 +168,7 @@ namespace Renderer {
 		GLuint program = glCreateProgram();
 		glAttachShader(program, vertexShaderHandle);
 		glAttachShader(program, fragmentShaderHandle);
+		PrepareProgramForCache(program);
 		glLinkProgram(program);
 
 		GLint isLinked = 0;
@@ -180,6 +192,10 @@ namespace Renderer {
 
 		glDetachShader(program, vertexShaderHandle);
 		glDetachShader(program, fragmentShaderHandle);
+		glDeleteShader(vertexShaderHandle);
+		glDeleteShader(fragmentShaderHandle);
+
+		StoreCachedProgram(cacheKey, program, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - compileStart).count());
 		return program;
 	}
 
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <filesystem>
+#include <string>
 
 namespace Renderer {
 
+	// Source with includes expanded, as handed to the driver (see ShaderPreprocessor.h)
+	std::string LoadShaderSource(const std::filesystem::path& path);
+
 	uint32_t CreateComputeShader(const std::filesystem::path& path);
 	uint32_t ReloadComputeShader(uint32_t shaderHandle, const std::filesystem::path& path);
 
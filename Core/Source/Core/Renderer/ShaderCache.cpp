@@ -0,0 +1,194 @@
+#include "ShaderCache.h"
+
+#include "Core/Debug/Profiler.h"
+#include "Core/Hash.h"
+
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <print>
+#include <vector>
+
+namespace Renderer {
+
+	static constexpr uint32_t CacheMagic = 0x42485343; // 'CSHB'
+	static constexpr uint32_t CacheVersion = 1;
+
+	struct CacheFileHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint64_t Key;
+		uint32_t BinaryFormat;
+		uint32_t BinarySize;
+		double CompileMillis;
+	};
+
+	struct ShaderCacheData
+	{
+		std::mutex Mutex;
+		std::filesystem::path Directory = "Cache/Shaders";
+		uint64_t DriverHash = 0;
+		ShaderCacheStats Stats;
+	};
+
+	static ShaderCacheData s_Data;
+
+	static std::filesystem::path GetCacheFilePath(uint64_t key)
+	{
+		return s_Data.Directory / std::format("{:016x}.bin", key);
+	}
+
+	static bool IsCacheSupported()
+	{
+		if (s_Data.Directory.empty())
+			return false;
+
+		GLint formatCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+		return formatCount > 0;
+	}
+
+	void SetShaderCacheDirectory(const std::filesystem::path& directory)
+	{
+		std::scoped_lock lock(s_Data.Mutex);
+		s_Data.Directory = directory;
+	}
+
+	uint64_t ComputeShaderCacheKey(std::initializer_list<std::string_view> sources)
+	{
+		std::scoped_lock lock(s_Data.Mutex);
+
+		if (s_Data.DriverHash == 0)
+		{
+			uint64_t hash = Core::Hash::FNVOffsetBasis;
+			for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+			{
+				const char* value = (const char*)glGetString(name);
+				hash = Core::Hash::FNV1a(value ? value : "", hash);
+			}
+			s_Data.DriverHash = hash;
+		}
+
+		uint64_t key = s_Data.DriverHash;
+		for (std::string_view source : sources)
+			key = Core::Hash::Combine(key, Core::Hash::FNV1a(source));
+
+		return key;
+	}
+
+	GLuint LoadCachedProgram(uint64_t key)
+	{
+		PROFILE_FUNC();
+
+		std::scoped_lock lock(s_Data.Mutex);
+
+		if (!IsCacheSupported())
+			return 0;
+
+		auto start = std::chrono::steady_clock::now();
+
+		std::filesystem::path path = GetCacheFilePath(key);
+		std::ifstream file(path, std::ios::binary);
+
+		CacheFileHeader header{};
+		if (!file.is_open() || !file.read((char*)&header, sizeof(header))
+			|| header.Magic != CacheMagic || header.Version != CacheVersion || header.Key != key)
+		{
+			s_Data.Stats.Misses++;
+			return 0;
+		}
+
+		std::vector<char> binary(header.BinarySize);
+		if (!file.read(binary.data(), binary.size()))
+		{
+			s_Data.Stats.Misses++;
+			return 0;
+		}
+
+		GLuint program = glCreateProgram();
+		glProgramBinary(program, header.BinaryFormat, binary.data(), (GLsizei)binary.size());
+
+		GLint isLinked = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+		if (isLinked == GL_FALSE)
+		{
+			// Driver no longer accepts this binary, drop it so it gets rebuilt
+			glDeleteProgram(program);
+			file.close();
+			std::error_code error;
+			std::filesystem::remove(path, error);
+
+			s_Data.Stats.Misses++;
+			return 0;
+		}
+
+		double loadMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		s_Data.Stats.Hits++;
+		s_Data.Stats.CompileMillisSaved += header.CompileMillis - loadMillis;
+		return program;
+	}
+
+	void PrepareProgramForCache(GLuint program)
+	{
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
+	void StoreCachedProgram(uint64_t key, GLuint program, double compileMillis)
+	{
+		PROFILE_FUNC();
+
+		std::scoped_lock lock(s_Data.Mutex);
+
+		s_Data.Stats.CompileMillis += compileMillis;
+
+		if (!IsCacheSupported())
+			return;
+
+		GLint binarySize = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+		if (binarySize <= 0)
+			return;
+
+		CacheFileHeader header{};
+		header.Magic = CacheMagic;
+		header.Version = CacheVersion;
+		header.Key = key;
+		header.CompileMillis = compileMillis;
+
+		std::vector<char> binary(binarySize);
+		GLenum binaryFormat = 0;
+		glGetProgramBinary(program, binarySize, nullptr, &binaryFormat, binary.data());
+		header.BinaryFormat = binaryFormat;
+		header.BinarySize = (uint32_t)binary.size();
+
+		std::error_code error;
+		std::filesystem::create_directories(s_Data.Directory, error);
+
+		std::ofstream file(GetCacheFilePath(key), std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			std::cerr << "Failed to write shader cache entry: " << GetCacheFilePath(key).string() << std::endl;
+			return;
+		}
+
+		file.write((const char*)&header, sizeof(header));
+		file.write(binary.data(), binary.size());
+	}
+
+	ShaderCacheStats GetShaderCacheStats()
+	{
+		std::scoped_lock lock(s_Data.Mutex);
+		return s_Data.Stats;
+	}
+
+	void LogShaderCacheStats()
+	{
+		ShaderCacheStats stats = GetShaderCacheStats();
+		std::println("[Shader Cache] {} hits, {} misses, {:.2f} ms compiling, {:.2f} ms saved",
+			stats.Hits, stats.Misses, stats.CompileMillis, stats.CompileMillisSaved);
+	}
+
+}
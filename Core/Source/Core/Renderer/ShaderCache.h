@@ -0,0 +1,36 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <filesystem>
+#include <initializer_list>
+#include <string_view>
+
+namespace Renderer {
+
+	struct ShaderCacheStats
+	{
+		uint32_t Hits = 0;
+		uint32_t Misses = 0;
+		double CompileMillis = 0.0;      // Spent compiling and linking on misses
+		double CompileMillisSaved = 0.0; // Original compile time of cache hits minus their load time
+	};
+
+	// On-disk cache of linked program binaries (glGetProgramBinary). Entries are keyed by
+	// a hash of the shader sources plus the driver vendor, renderer and version strings,
+	// so a driver update or a source edit simply misses. An empty directory disables it.
+	void SetShaderCacheDirectory(const std::filesystem::path& directory);
+
+	// GL thread only, the key includes the current context's driver strings
+	uint64_t ComputeShaderCacheKey(std::initializer_list<std::string_view> sources);
+
+	// Returns a linked program, or 0 on a miss or when the driver rejects the binary
+	GLuint LoadCachedProgram(uint64_t key);
+	// Call before glLinkProgram on programs that will be stored
+	void PrepareProgramForCache(GLuint program);
+	void StoreCachedProgram(uint64_t key, GLuint program, double compileMillis);
+
+	ShaderCacheStats GetShaderCacheStats();
+	void LogShaderCacheStats();
+
+}
@@ -0,0 +1,456 @@
+#include "ShaderHotReload.h"
+
+#include "Shader.h"
+#include "ShaderCache.h"
+#include "ShaderPreprocessor.h"
+
+#include "Core/Debug/MemoryTracker.h"
+#include "Core/Debug/Profiler.h"
+#include "Core/FileWatcher.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <print>
+#include <string>
+#include <thread>
+#include <vector>
+
+// KHR_parallel_shader_compile isn't part of the generated loader
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+
+namespace Renderer {
+
+	struct WatchedShader
+	{
+		uint32_t* Program = nullptr;
+		std::vector<std::filesystem::path> Stages; // Vertex and fragment, or a single compute stage
+		uint32_t Generation = 0;                   // Bumped per rebuild so stale builds get dropped
+	};
+
+	struct ShaderBuild
+	{
+		uint32_t* Program = nullptr;
+		uint32_t Generation = 0;
+		std::vector<std::filesystem::path> Stages;
+
+		GLuint NewProgram = 0;
+		std::vector<GLuint> Shaders; // Parallel compile only, kept for the info logs
+		GLsync Fence = nullptr;      // Worker compile only
+		bool Failed = false;
+
+		uint64_t CacheKey = 0;
+		std::chrono::steady_clock::time_point StartTime;
+	};
+
+	struct ShaderHotReloadData
+	{
+		std::mutex Mutex;
+		std::unique_ptr<Core::FileWatcher> Watcher;
+		std::vector<WatchedShader> Shaders;
+
+		// GL thread only
+		std::vector<ShaderBuild> PendingBuilds;
+
+		bool ParallelCompile = false;
+
+		// Fallback when the driver can't compile in the background itself
+		GLFWwindow* WorkerContext = nullptr;
+		std::thread WorkerThread;
+		std::mutex WorkerMutex;
+		std::condition_variable WorkerCondition;
+		std::deque<ShaderBuild> WorkerQueue;
+		std::vector<ShaderBuild> WorkerResults;
+		bool WorkerRunning = false;
+	};
+
+	static ShaderHotReloadData* s_Data = nullptr;
+
+	static std::filesystem::path NormalizePath(const std::filesystem::path& path)
+	{
+		std::error_code error;
+		std::filesystem::path result = std::filesystem::weakly_canonical(std::filesystem::absolute(path), error);
+		return error ? path : result;
+	}
+
+	static void CompileOnWorker()
+	{
+		PROFILE_THREAD("Shader Compiler");
+		Core::SetAllocationThreadName("Shader Compiler");
+
+		glfwMakeContextCurrent(s_Data->WorkerContext);
+
+		while (true)
+		{
+			ShaderBuild build;
+			{
+				std::unique_lock lock(s_Data->WorkerMutex);
+				s_Data->WorkerCondition.wait(lock, [] { return !s_Data->WorkerRunning || !s_Data->WorkerQueue.empty(); });
+
+				if (!s_Data->WorkerRunning)
+					break;
+
+				build = std::move(s_Data->WorkerQueue.front());
+				s_Data->WorkerQueue.pop_front();
+			}
+
+			GLuint program = build.Stages.size() == 1
+				? CreateComputeShader(build.Stages[0])
+				: CreateGraphicsShader(build.Stages[0], build.Stages[1]);
+
+			build.Failed = program == (GLuint)-1;
+			build.NewProgram = build.Failed ? 0 : program;
+
+			// The program is complete for other contexts once the fence passes
+			build.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			glFlush();
+
+			std::scoped_lock lock(s_Data->WorkerMutex);
+			s_Data->WorkerResults.push_back(std::move(build));
+		}
+
+		glfwMakeContextCurrent(nullptr);
+	}
+
+	void InitShaderHotReload(GLFWwindow* window, const std::filesystem::path& directory)
+	{
+		PROFILE_FUNC();
+
+		if (directory.empty() || !std::filesystem::is_directory(directory))
+			return;
+
+		s_Data = new ShaderHotReloadData();
+		s_Data->Watcher = Core::FileWatcher::Create(NormalizePath(directory));
+
+		auto maxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)nullptr;
+		if (glfwExtensionSupported("GL_KHR_parallel_shader_compile"))
+			maxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+		else if (glfwExtensionSupported("GL_ARB_parallel_shader_compile"))
+			maxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
+
+		if (maxShaderCompilerThreads)
+		{
+			// Let the driver pick its own thread count
+			maxShaderCompilerThreads(0xFFFFFFFF);
+			s_Data->ParallelCompile = true;
+			return;
+		}
+
+		// Hints left over from the main window's creation keep the context versions matching
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		s_Data->WorkerContext = glfwCreateWindow(1, 1, "Shader Compiler", nullptr, window);
+		glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+
+		if (!s_Data->WorkerContext)
+		{
+			std::cerr << "[Shader Hot Reload] Failed to create compile context, shader reloads will block" << std::endl;
+			return;
+		}
+
+		s_Data->WorkerRunning = true;
+		s_Data->WorkerThread = std::thread(CompileOnWorker);
+	}
+
+	static void DeleteBuild(ShaderBuild& build)
+	{
+		for (GLuint shader : build.Shaders)
+			glDeleteShader(shader);
+		if (build.NewProgram)
+			glDeleteProgram(build.NewProgram);
+		if (build.Fence)
+			glDeleteSync(build.Fence);
+
+		build.Shaders.clear();
+		build.NewProgram = 0;
+		build.Fence = nullptr;
+	}
+
+	void ShutdownShaderHotReload()
+	{
+		PROFILE_FUNC();
+
+		if (!s_Data)
+			return;
+
+		if (s_Data->WorkerThread.joinable())
+		{
+			{
+				std::scoped_lock lock(s_Data->WorkerMutex);
+				s_Data->WorkerRunning = false;
+			}
+			s_Data->WorkerCondition.notify_one();
+			s_Data->WorkerThread.join();
+		}
+
+		for (ShaderBuild& build : s_Data->PendingBuilds)
+			DeleteBuild(build);
+		for (ShaderBuild& build : s_Data->WorkerResults)
+			DeleteBuild(build);
+
+		if (s_Data->WorkerContext)
+			glfwDestroyWindow(s_Data->WorkerContext);
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	static void Watch(uint32_t* program, std::vector<std::filesystem::path> stages)
+	{
+		if (!s_Data)
+			return;
+
+		for (std::filesystem::path& stage : stages)
+			stage = NormalizePath(stage);
+
+		std::scoped_lock lock(s_Data->Mutex);
+		s_Data->Shaders.push_back({ program, std::move(stages) });
+	}
+
+	void WatchGraphicsShader(uint32_t* program, const std::filesystem::path& vertexPath, const std::filesystem::path& fragmentPath)
+	{
+		Watch(program, { vertexPath, fragmentPath });
+	}
+
+	void WatchComputeShader(uint32_t* program, const std::filesystem::path& path)
+	{
+		Watch(program, { path });
+	}
+
+	void UnwatchShader(uint32_t* program)
+	{
+		if (!s_Data)
+			return;
+
+		std::scoped_lock lock(s_Data->Mutex);
+		std::erase_if(s_Data->Shaders, [program](const WatchedShader& shader) { return shader.Program == program; });
+	}
+
+	static void StartParallelBuild(ShaderBuild& build)
+	{
+		PROFILE_FUNC();
+
+		std::vector<std::string> sources;
+		for (const std::filesystem::path& stage : build.Stages)
+			sources.push_back(LoadShaderSource(stage));
+
+		build.CacheKey = sources.size() == 1
+			? ComputeShaderCacheKey({ sources[0] })
+			: ComputeShaderCacheKey({ sources[0], sources[1] });
+
+		// Reverting an edit usually lands on a binary that is already cached
+		build.NewProgram = LoadCachedProgram(build.CacheKey);
+		if (build.NewProgram)
+			return;
+
+		const GLenum stageTypes[2] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER };
+
+		build.NewProgram = glCreateProgram();
+		for (size_t i = 0; i < sources.size(); i++)
+		{
+			GLuint shader = glCreateShader(sources.size() == 1 ? GL_COMPUTE_SHADER : stageTypes[i]);
+			const GLchar* source = (const GLchar*)sources[i].c_str();
+			glShaderSource(shader, 1, &source, 0);
+			glCompileShader(shader);
+			glAttachShader(build.NewProgram, shader);
+			build.Shaders.push_back(shader);
+		}
+
+		PrepareProgramForCache(build.NewProgram);
+		glLinkProgram(build.NewProgram);
+	}
+
+	static void StartBuild(WatchedShader& shader)
+	{
+		ShaderBuild build;
+		build.Program = shader.Program;
+		build.Generation = ++shader.Generation;
+		build.Stages = shader.Stages;
+		build.StartTime = std::chrono::steady_clock::now();
+
+		if (s_Data->ParallelCompile)
+		{
+			StartParallelBuild(build);
+			s_Data->PendingBuilds.push_back(std::move(build));
+		}
+		else if (s_Data->WorkerRunning)
+		{
+			{
+				std::scoped_lock lock(s_Data->WorkerMutex);
+				s_Data->WorkerQueue.push_back(std::move(build));
+			}
+			s_Data->WorkerCondition.notify_one();
+		}
+		else
+		{
+			build.NewProgram = build.Stages.size() == 1
+				? CreateComputeShader(build.Stages[0])
+				: CreateGraphicsShader(build.Stages[0], build.Stages[1]);
+			build.Failed = build.NewProgram == (GLuint)-1;
+			if (build.Failed)
+				build.NewProgram = 0;
+			s_Data->PendingBuilds.push_back(std::move(build));
+		}
+	}
+
+	// Returns true once the build has finished, successfully or not
+	static bool IsBuildComplete(ShaderBuild& build)
+	{
+		if (build.Failed)
+			return true;
+
+		if (build.Fence)
+		{
+			GLenum status = glClientWaitSync(build.Fence, 0, 0);
+			return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+		}
+
+		if (build.Shaders.empty())
+			return true;
+
+		GLint isComplete = GL_FALSE;
+		glGetProgramiv(build.NewProgram, GL_COMPLETION_STATUS_KHR, &isComplete);
+		return isComplete == GL_TRUE;
+	}
+
+	static void LogBuildErrors(const ShaderBuild& build)
+	{
+		for (size_t i = 0; i < build.Shaders.size(); i++)
+		{
+			GLint isCompiled = 0;
+			glGetShaderiv(build.Shaders[i], GL_COMPILE_STATUS, &isCompiled);
+			if (isCompiled == GL_TRUE)
+				continue;
+
+			GLint maxLength = 0;
+			glGetShaderiv(build.Shaders[i], GL_INFO_LOG_LENGTH, &maxLength);
+
+			std::vector<GLchar> infoLog(maxLength + 1);
+			glGetShaderInfoLog(build.Shaders[i], maxLength, &maxLength, &infoLog[0]);
+			std::cerr << build.Stages[i].string() << " (source strings: " << DescribeShaderSourceStrings(*PreprocessShader(build.Stages[i])) << "):\n" << infoLog.data() << std::endl;
+		}
+
+		GLint maxLength = 0;
+		glGetProgramiv(build.NewProgram, GL_INFO_LOG_LENGTH, &maxLength);
+		if (maxLength > 0)
+		{
+			std::vector<GLchar> infoLog(maxLength + 1);
+			glGetProgramInfoLog(build.NewProgram, maxLength, &maxLength, &infoLog[0]);
+			std::cerr << infoLog.data() << std::endl;
+		}
+	}
+
+	// Returns false if the build failed to compile or link
+	static bool FinishBuild(ShaderBuild& build)
+	{
+		if (build.Failed)
+			return false;
+
+		if (build.Fence)
+		{
+			glDeleteSync(build.Fence);
+			build.Fence = nullptr;
+			return true;
+		}
+
+		// Parallel compile, or a cache hit when there are no shaders
+		if (build.Shaders.empty())
+			return true;
+
+		GLint isLinked = 0;
+		glGetProgramiv(build.NewProgram, GL_LINK_STATUS, &isLinked);
+		if (isLinked == GL_FALSE)
+		{
+			LogBuildErrors(build);
+			return false;
+		}
+
+		double compileMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build.StartTime).count();
+		StoreCachedProgram(build.CacheKey, build.NewProgram, compileMillis);
+
+		for (GLuint shader : build.Shaders)
+		{
+			glDetachShader(build.NewProgram, shader);
+			glDeleteShader(shader);
+		}
+		build.Shaders.clear();
+		return true;
+	}
+
+	void UpdateShaderHotReload()
+	{
+		PROFILE_FUNC();
+
+		if (!s_Data)
+			return;
+
+		std::vector<std::filesystem::path> changes = s_Data->Watcher ? s_Data->Watcher->PollChanges() : std::vector<std::filesystem::path>();
+		if (!changes.empty())
+		{
+			// An edited header rebuilds every shader that includes it
+			changes = GetShaderDependents(changes);
+
+			std::scoped_lock lock(s_Data->Mutex);
+			for (WatchedShader& shader : s_Data->Shaders)
+			{
+				bool affected = std::ranges::any_of(shader.Stages, [&](const std::filesystem::path& stage)
+				{
+					return std::ranges::find(changes, stage) != changes.end();
+				});
+
+				if (affected)
+					StartBuild(shader);
+			}
+		}
+
+		if (s_Data->WorkerRunning)
+		{
+			std::scoped_lock lock(s_Data->WorkerMutex);
+			for (ShaderBuild& build : s_Data->WorkerResults)
+				s_Data->PendingBuilds.push_back(std::move(build));
+			s_Data->WorkerResults.clear();
+		}
+
+		if (s_Data->PendingBuilds.empty())
+			return;
+
+		std::scoped_lock lock(s_Data->Mutex);
+
+		std::erase_if(s_Data->PendingBuilds, [](ShaderBuild& build)
+		{
+			if (!IsBuildComplete(build))
+				return false;
+
+			const bool succeeded = FinishBuild(build);
+
+			auto it = std::ranges::find(s_Data->Shaders, build.Program, &WatchedShader::Program);
+			const bool current = it != s_Data->Shaders.end() && it->Generation == build.Generation;
+
+			if (!succeeded)
+			{
+				std::cerr << "[Shader Hot Reload] Failed to rebuild " << build.Stages[0].filename().string() << ", keeping the previous program" << std::endl;
+			}
+			else if (current)
+			{
+				glDeleteProgram(*build.Program);
+				*build.Program = build.NewProgram;
+				build.NewProgram = 0;
+
+				double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build.StartTime).count();
+				std::println("[Shader Hot Reload] Reloaded {} ({:.2f} ms)", build.Stages[0].filename().string(), millis);
+			}
+
+			// Superseded by a newer edit, or the owner stopped watching
+			DeleteBuild(build);
+			return true;
+		});
+	}
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <filesystem>
+#include <stdint.h>
+
+struct GLFWwindow;
+
+namespace Renderer {
+
+	// Watches directory for shader edits and rebuilds affected programs without stalling the
+	// frame: through KHR_parallel_shader_compile when the driver has it, otherwise on a worker
+	// thread with a hidden context shared with window. Call on the main thread with window's
+	// context current, before any render thread takes it. An empty directory disables reloading.
+	void InitShaderHotReload(GLFWwindow* window, const std::filesystem::path& directory);
+	// Main thread, once the render thread has handed the context back
+	void ShutdownShaderHotReload();
+
+	// Rebuilt programs replace *program only after they link, the previous program is deleted
+	// then. Failed builds are logged and leave the old program in place. Safe from any thread.
+	void WatchGraphicsShader(uint32_t* program, const std::filesystem::path& vertexPath, const std::filesystem::path& fragmentPath);
+	void WatchComputeShader(uint32_t* program, const std::filesystem::path& path);
+	void UnwatchShader(uint32_t* program);
+
+	// Picks up file changes, starts rebuilds and swaps in finished programs. GL thread, once per frame.
+	void UpdateShaderHotReload();
+
+}
@@ -0,0 +1,247 @@
+#include "ShaderPreprocessor.h"
+
+#include "Core/Debug/Profiler.h"
+#include "Core/Hash.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+
+namespace Renderer {
+
+	struct SourceFile
+	{
+		std::filesystem::file_time_type WriteTime;
+		uintmax_t Size = 0;
+		std::string Text;
+		uint64_t Hash = 0;
+	};
+
+	struct MemoizedShader
+	{
+		std::shared_ptr<const PreprocessedShader> Result;
+		std::vector<std::pair<std::string, uint64_t>> Dependencies; // Every file read, with its content hash
+	};
+
+	// Paths are keyed by their normalized string form
+	struct ShaderPreprocessorData
+	{
+		std::mutex Mutex;
+		std::unordered_map<std::string, SourceFile> Files;
+		std::unordered_map<std::string, MemoizedShader> Memo;
+		std::unordered_map<std::string, std::set<std::string>> Includers; // Included file -> files including it
+	};
+
+	static ShaderPreprocessorData s_Data;
+
+	struct ExpandContext
+	{
+		PreprocessedShader* Output = nullptr;
+		std::vector<std::pair<std::string, uint64_t>> Dependencies;
+		std::set<std::string> PragmaOnce;
+		std::vector<std::string> IncludeStack;
+	};
+
+	static std::filesystem::path NormalizePath(const std::filesystem::path& path)
+	{
+		std::error_code error;
+		std::filesystem::path result = std::filesystem::weakly_canonical(std::filesystem::absolute(path), error);
+		return error ? path : result;
+	}
+
+	// Caller must hold s_Data.Mutex. Only re-reads files whose size or write time changed.
+	static const SourceFile* LoadSourceFile(const std::string& path)
+	{
+		std::error_code error;
+		auto writeTime = std::filesystem::last_write_time(path, error);
+		auto size = error ? 0 : std::filesystem::file_size(path, error);
+		if (error)
+		{
+			s_Data.Files.erase(path);
+			return nullptr;
+		}
+
+		auto it = s_Data.Files.find(path);
+		if (it != s_Data.Files.end() && it->second.WriteTime == writeTime && it->second.Size == size)
+			return &it->second;
+
+		std::ifstream file(path);
+		if (!file.is_open())
+			return nullptr;
+
+		std::ostringstream contentStream;
+		contentStream << file.rdbuf();
+
+		SourceFile& source = s_Data.Files[path];
+		source.WriteTime = writeTime;
+		source.Size = size;
+		source.Text = contentStream.str();
+		source.Hash = Core::Hash::FNV1a(source.Text);
+		return &source;
+	}
+
+	static std::string_view TrimLeft(std::string_view text)
+	{
+		size_t start = text.find_first_not_of(" \t");
+		return start == std::string_view::npos ? std::string_view() : text.substr(start);
+	}
+
+	// Caller must hold s_Data.Mutex
+	static void ExpandFile(const std::string& path, uint32_t fileIndex, ExpandContext& context)
+	{
+		const SourceFile* file = LoadSourceFile(path);
+		context.Dependencies.push_back({ path, file ? file->Hash : 0 });
+
+		if (!file)
+		{
+			std::cerr << "Failed to open file: " << path << std::endl;
+			return;
+		}
+
+		context.IncludeStack.push_back(path);
+
+		std::string& output = context.Output->Source;
+		std::string_view text = file->Text;
+		uint32_t lineNumber = 0;
+
+		while (!text.empty())
+		{
+			size_t end = text.find('\n');
+			std::string_view line = text.substr(0, end);
+			text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+			lineNumber++;
+
+			std::string_view directive = TrimLeft(line);
+			if (!directive.starts_with('#'))
+			{
+				output.append(line);
+				output.push_back('\n');
+				continue;
+			}
+
+			directive = TrimLeft(directive.substr(1));
+
+			if (directive.starts_with("pragma") && TrimLeft(directive.substr(6)).starts_with("once"))
+			{
+				context.PragmaOnce.insert(path);
+				output.push_back('\n');
+				continue;
+			}
+
+			if (!directive.starts_with("include"))
+			{
+				output.append(line);
+				output.push_back('\n');
+				continue;
+			}
+
+			std::string_view argument = TrimLeft(directive.substr(7));
+			size_t nameEnd = argument.size() > 1 ? argument.find(argument[0] == '<' ? '>' : '"', 1) : std::string_view::npos;
+			if ((!argument.starts_with('"') && !argument.starts_with('<')) || nameEnd == std::string_view::npos)
+			{
+				std::cerr << path << "(" << lineNumber << "): malformed #include" << std::endl;
+				output.push_back('\n');
+				continue;
+			}
+
+			std::filesystem::path includePath = std::filesystem::path(path).parent_path() / argument.substr(1, nameEnd - 1);
+			std::string include = NormalizePath(includePath).string();
+
+			s_Data.Includers[include].insert(path);
+
+			if (std::ranges::find(context.IncludeStack, include) != context.IncludeStack.end())
+			{
+				std::cerr << path << "(" << lineNumber << "): recursive #include of " << include << std::endl;
+				output.push_back('\n');
+				continue;
+			}
+
+			if (context.PragmaOnce.contains(include))
+			{
+				output.push_back('\n');
+				continue;
+			}
+
+			uint32_t includeIndex = (uint32_t)context.Output->Files.size();
+			context.Output->Files.push_back(include);
+
+			output.append(std::format("#line 1 {}\n", includeIndex));
+			ExpandFile(include, includeIndex, context);
+			output.append(std::format("#line {} {}\n", lineNumber + 1, fileIndex));
+		}
+
+		context.IncludeStack.pop_back();
+	}
+
+	std::shared_ptr<const PreprocessedShader> PreprocessShader(const std::filesystem::path& path)
+	{
+		PROFILE_FUNC();
+
+		std::string root = NormalizePath(path).string();
+
+		std::scoped_lock lock(s_Data.Mutex);
+
+		if (auto it = s_Data.Memo.find(root); it != s_Data.Memo.end())
+		{
+			bool unchanged = std::ranges::all_of(it->second.Dependencies, [](const std::pair<std::string, uint64_t>& dependency)
+			{
+				const SourceFile* file = LoadSourceFile(dependency.first);
+				return (file ? file->Hash : 0) == dependency.second;
+			});
+
+			if (unchanged)
+				return it->second.Result;
+		}
+
+		auto result = std::make_shared<PreprocessedShader>();
+		result->Files.push_back(root);
+
+		ExpandContext context;
+		context.Output = result.get();
+		ExpandFile(root, 0, context);
+
+		MemoizedShader& memo = s_Data.Memo[root];
+		memo.Result = result;
+		memo.Dependencies = std::move(context.Dependencies);
+		return result;
+	}
+
+	std::vector<std::filesystem::path> GetShaderDependents(const std::vector<std::filesystem::path>& files)
+	{
+		std::scoped_lock lock(s_Data.Mutex);
+
+		std::set<std::string> visited;
+		std::vector<std::string> stack;
+		for (const std::filesystem::path& file : files)
+			stack.push_back(NormalizePath(file).string());
+
+		while (!stack.empty())
+		{
+			std::string file = std::move(stack.back());
+			stack.pop_back();
+
+			if (!visited.insert(file).second)
+				continue;
+
+			if (auto it = s_Data.Includers.find(file); it != s_Data.Includers.end())
+				stack.insert(stack.end(), it->second.begin(), it->second.end());
+		}
+
+		return std::vector<std::filesystem::path>(visited.begin(), visited.end());
+	}
+
+	std::string DescribeShaderSourceStrings(const PreprocessedShader& shader)
+	{
+		std::string result;
+		for (size_t i = 0; i < shader.Files.size(); i++)
+			result += std::format("{}{} = {}", i > 0 ? ", " : "", i, shader.Files[i].filename().string());
+		return result;
+	}
+
+}
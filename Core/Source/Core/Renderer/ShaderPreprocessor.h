@@ -0,0 +1,30 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Renderer {
+
+	struct PreprocessedShader
+	{
+		std::string Source;
+		// Indexed by the source string number in the emitted #line directives, [0] is the shader itself
+		std::vector<std::filesystem::path> Files;
+	};
+
+	// Expands #include "file" (relative to the including file) and honours #pragma once.
+	// #line directives map driver errors back to the original file and line. Results are
+	// memoized per shader and reused while every file it pulled in still hashes the same.
+	// Safe to call from any thread.
+	std::shared_ptr<const PreprocessedShader> PreprocessShader(const std::filesystem::path& path);
+
+	// Every file that includes one of files, directly or not, plus files themselves.
+	// Only knows about includes seen by PreprocessShader so far.
+	std::vector<std::filesystem::path> GetShaderDependents(const std::vector<std::filesystem::path>& files);
+
+	// "0 = Flame.frag.glsl, 1 = Noise.glslh" for reading driver error logs
+	std::string DescribeShaderSourceStrings(const PreprocessedShader& shader);
+
+}
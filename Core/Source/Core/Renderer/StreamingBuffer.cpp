@@ -0,0 +1,140 @@
+#include "StreamingBuffer.h"
+
+#include "Core/Debug/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace Renderer {
+
+	static StreamingBuffer s_StreamingBuffer;
+
+	static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	StreamingBuffer::~StreamingBuffer()
+	{
+		// Needs the context, owners call Destroy on the GL thread
+		if (m_Handle)
+			std::cerr << "StreamingBuffer destroyed without Destroy, leaking the buffer" << std::endl;
+	}
+
+	void StreamingBuffer::Create(uint64_t frameSize, uint32_t frameCount)
+	{
+		PROFILE_FUNC();
+
+		Destroy();
+
+		GLint uniformAlignment = 256, storageAlignment = 256;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+		glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+		m_UniformAlignment = (uint64_t)uniformAlignment;
+		m_StorageAlignment = (uint64_t)storageAlignment;
+
+		// Regions start aligned for any kind of binding
+		m_FrameSize = AlignUp(frameSize, std::max<uint64_t>({ m_UniformAlignment, m_StorageAlignment, 256 }));
+		m_FrameCount = std::clamp(frameCount, 1u, MaxFrames);
+
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glCreateBuffers(1, &m_Handle);
+		glNamedBufferStorage(m_Handle, m_FrameSize * m_FrameCount, nullptr, flags);
+		m_Data = (uint8_t*)glMapNamedBufferRange(m_Handle, 0, m_FrameSize * m_FrameCount, flags);
+
+		m_Frame = 0;
+		m_Cursor = 0;
+		m_InFrame = false;
+	}
+
+	void StreamingBuffer::Destroy()
+	{
+		if (!m_Handle)
+			return;
+
+		for (GLsync& fence : m_Fences)
+		{
+			if (fence)
+				glDeleteSync(fence);
+			fence = nullptr;
+		}
+
+		glUnmapNamedBuffer(m_Handle);
+		glDeleteBuffers(1, &m_Handle);
+		m_Handle = 0;
+		m_Data = nullptr;
+	}
+
+	void StreamingBuffer::BeginFrame()
+	{
+		if (!m_Handle)
+			return;
+
+		m_Frame = (m_Frame + 1) % m_FrameCount;
+		m_Cursor = 0;
+		m_InFrame = true;
+
+		GLsync& fence = m_Fences[m_Frame];
+		if (!fence)
+			return;
+
+		GLenum status = glClientWaitSync(fence, 0, 0);
+		if (status == GL_TIMEOUT_EXPIRED)
+		{
+			// The GPU is still reading this region, more than frameCount - 1 frames behind
+			PROFILE_SCOPE("StreamingBuffer::WaitForFence");
+
+			const auto start = std::chrono::steady_clock::now();
+			while (status == GL_TIMEOUT_EXPIRED)
+				status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+
+			m_Stats.FenceWaits++;
+			m_Stats.FenceWaitNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+	void StreamingBuffer::EndFrame()
+	{
+		if (!m_InFrame)
+			return;
+
+		m_Fences[m_Frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_InFrame = false;
+
+		m_Stats.BytesLastFrame = m_Cursor;
+		m_Stats.PeakFrameBytes = std::max(m_Stats.PeakFrameBytes, m_Cursor);
+	}
+
+	StreamingAllocation StreamingBuffer::Allocate(uint64_t size, uint64_t alignment)
+	{
+		if (!m_InFrame)
+			return {};
+
+		const uint64_t offset = AlignUp(m_Cursor, alignment);
+		if (offset + size > m_FrameSize)
+		{
+			if (m_Stats.FailedAllocations++ == 0)
+				std::cerr << "StreamingBuffer frame region of " << m_FrameSize << " bytes is full" << std::endl;
+			return {};
+		}
+
+		m_Cursor = offset + size;
+
+		StreamingAllocation allocation;
+		allocation.Buffer = m_Handle;
+		allocation.Offset = (GLintptr)(m_Frame * m_FrameSize + offset);
+		allocation.Size = (GLsizeiptr)size;
+		allocation.Data = m_Data + allocation.Offset;
+		return allocation;
+	}
+
+	StreamingBuffer& GetStreamingBuffer()
+	{
+		return s_StreamingBuffer;
+	}
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <stdint.h>
+
+namespace Renderer {
+
+	struct StreamingAllocation
+	{
+		GLuint Buffer = 0;
+		GLintptr Offset = 0;
+		GLsizeiptr Size = 0;
+		void* Data = nullptr; // Write-only, coherent. Null when the frame's region is full.
+
+		explicit operator bool() const { return Data != nullptr; }
+	};
+
+	struct StreamingBufferStats
+	{
+		uint64_t BytesLastFrame = 0;
+		uint64_t PeakFrameBytes = 0;
+		uint64_t FailedAllocations = 0; // Didn't fit in their frame's region
+		uint64_t FenceWaits = 0;        // Frames that had to wait for the GPU to release their region
+		uint64_t FenceWaitNs = 0;
+	};
+
+	// One persistently mapped buffer split into a region per frame in flight. Sub-allocations
+	// are written straight through the mapping, a region is only reused once the fence placed
+	// after its frame has signaled. GL thread only.
+	class StreamingBuffer
+	{
+	public:
+		StreamingBuffer() = default;
+		~StreamingBuffer();
+
+		StreamingBuffer(const StreamingBuffer&) = delete;
+		StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+		void Create(uint64_t frameSize, uint32_t frameCount = 3);
+		void Destroy();
+
+		// Moves to the next region, waiting for the GPU to be done with it if it has to
+		void BeginFrame();
+		// Fences the current region
+		void EndFrame();
+
+		StreamingAllocation Allocate(uint64_t size, uint64_t alignment = 16);
+		// Aligned for binding with glBindBufferRange
+		StreamingAllocation AllocateUniform(uint64_t size) { return Allocate(size, m_UniformAlignment); }
+		StreamingAllocation AllocateStorage(uint64_t size) { return Allocate(size, m_StorageAlignment); }
+
+		GLuint GetHandle() const { return m_Handle; }
+		bool IsCreated() const { return m_Handle != 0; }
+
+		const StreamingBufferStats& GetStats() const { return m_Stats; }
+	private:
+		static constexpr uint32_t MaxFrames = 4;
+
+		GLuint m_Handle = 0;
+		uint8_t* m_Data = nullptr;
+		uint64_t m_FrameSize = 0;
+		uint32_t m_FrameCount = 0;
+
+		uint32_t m_Frame = 0;
+		uint64_t m_Cursor = 0; // Within the current region
+		bool m_InFrame = false;
+		GLsync m_Fences[MaxFrames] = {};
+
+		uint64_t m_UniformAlignment = 256;
+		uint64_t m_StorageAlignment = 256;
+
+		StreamingBufferStats m_Stats;
+	};
+
+	// Shared by the renderer for per-frame data, Application creates it and drives the frames
+	StreamingBuffer& GetStreamingBuffer();
+
+}
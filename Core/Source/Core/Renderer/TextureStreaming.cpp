@@ -0,0 +1,387 @@
+#include "TextureStreaming.h"
+
+#include "Core/Debug/Profiler.h"
+#include "Core/Jobs/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "stb_image.h"
+
+namespace Renderer {
+
+	static constexpr uint32_t StagingBufferCount = 4;
+	static constexpr uint32_t StagingBufferSize = 16 * 1024 * 1024; // Fits a 2048x2048 RGBA8 image
+
+	struct StagingBuffer
+	{
+		GLuint Handle = 0;
+		uint8_t* Data = nullptr;
+		bool InUse = false;
+	};
+
+	struct StreamingRequest
+	{
+		enum class State
+		{
+			Decoding, Uploading, Finishing
+		};
+
+		std::filesystem::path Path;
+		Texture Target;
+		State CurrentState = State::Decoding;
+
+		// Decoded pixels live either in a staging buffer or, if none was free or the
+		// image is too large, in the stb allocation until a staging buffer frees up
+		int32_t StagingIndex = -1;
+		uint8_t* Pixels = nullptr;
+		bool Decoded = false;
+		bool Failed = false;
+		bool Cancelled = false; // The texture was deleted before it finished loading
+
+		uint32_t RowsUploaded = 0;
+		GLsync Fence = nullptr;
+	};
+
+	struct TextureStreamingData
+	{
+		std::mutex Mutex;
+		StagingBuffer StagingBuffers[StagingBufferCount];
+		std::unordered_map<GLuint, std::shared_ptr<StreamingRequest>> Requests;
+		std::vector<std::shared_ptr<StreamingRequest>> UploadQueue;
+		Core::JobHandle DecodeJobs;
+
+		uint64_t BytesUploadedLastFrame = 0;
+		uint64_t TotalTexturesLoaded = 0;
+	};
+
+	static TextureStreamingData* s_Data = nullptr;
+
+	static void InitTextureStreaming()
+	{
+		PROFILE_FUNC();
+
+		s_Data = new TextureStreamingData();
+
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		for (StagingBuffer& staging : s_Data->StagingBuffers)
+		{
+			glCreateBuffers(1, &staging.Handle);
+			glNamedBufferStorage(staging.Handle, StagingBufferSize, nullptr, flags);
+			staging.Data = (uint8_t*)glMapNamedBufferRange(staging.Handle, 0, StagingBufferSize, flags);
+		}
+	}
+
+	// Caller must hold s_Data->Mutex
+	static int32_t AcquireStagingBuffer(uint64_t size)
+	{
+		if (size > StagingBufferSize)
+			return -1;
+
+		for (int32_t i = 0; i < (int32_t)StagingBufferCount; i++)
+		{
+			if (!s_Data->StagingBuffers[i].InUse)
+			{
+				s_Data->StagingBuffers[i].InUse = true;
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	static void DecodeTexture(const std::shared_ptr<StreamingRequest>& request)
+	{
+		PROFILE_FUNC();
+
+		int width, height, channels;
+		std::string filepath = request->Path.string();
+		stbi_set_flip_vertically_on_load_thread(1);
+		uint8_t* pixels = stbi_load(filepath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+
+		const bool failed = !pixels || (uint32_t)width != request->Target.Width || (uint32_t)height != request->Target.Height;
+		if (failed)
+		{
+			std::cerr << "Failed to load texture: " << filepath << "\n";
+			stbi_image_free(pixels);
+			pixels = nullptr;
+		}
+
+		// ProcessTextureUploads holds the mutex on the GL thread, so only the staging buffer
+		// is picked under it. Nobody else touches the buffer once it's in use.
+		const uint64_t size = (uint64_t)width * height * 4;
+		int32_t stagingIndex = -1;
+		if (!failed)
+		{
+			std::scoped_lock lock(s_Data->Mutex);
+			stagingIndex = AcquireStagingBuffer(size);
+		}
+
+		if (stagingIndex >= 0)
+		{
+			memcpy(s_Data->StagingBuffers[stagingIndex].Data, pixels, size);
+			stbi_image_free(pixels);
+			pixels = nullptr;
+		}
+
+		std::scoped_lock lock(s_Data->Mutex);
+
+		request->Decoded = true;
+		request->Failed = failed;
+		request->StagingIndex = stagingIndex;
+		request->Pixels = pixels;
+
+		if (!failed)
+			request->CurrentState = StreamingRequest::State::Uploading;
+	}
+
+	Texture LoadTextureAsync(const std::filesystem::path& path)
+	{
+		PROFILE_FUNC();
+
+		if (!s_Data)
+			InitTextureStreaming();
+
+		// Only the header is read here, the decode happens on a worker
+		int width, height, channels;
+		std::string filepath = path.string();
+		if (!stbi_info(filepath.c_str(), &width, &height, &channels))
+		{
+			std::cerr << "Failed to load texture: " << filepath << "\n";
+			return {};
+		}
+
+		Texture result;
+		result.Width = width;
+		result.Height = height;
+
+		const GLsizei levels = (GLsizei)std::floor(std::log2(std::max(width, height))) + 1;
+
+		glCreateTextures(GL_TEXTURE_2D, 1, &result.Handle);
+
+		glTextureStorage2D(result.Handle, levels, GL_RGBA8, width, height);
+
+		// Placeholder until the real data lands
+		const uint8_t placeholder[4] = { 0, 0, 0, 0 };
+		for (GLint level = 0; level < levels; level++)
+			glClearTexImage(result.Handle, level, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+
+		glTextureParameteri(result.Handle, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTextureParameteri(result.Handle, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		glTextureParameteri(result.Handle, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTextureParameteri(result.Handle, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+		auto request = std::make_shared<StreamingRequest>();
+		request->Path = path;
+		request->Target = result;
+
+		{
+			std::scoped_lock lock(s_Data->Mutex);
+			s_Data->Requests[result.Handle] = request;
+			s_Data->UploadQueue.push_back(request);
+		}
+
+		Core::JobSystem::Schedule(s_Data->DecodeJobs, [request]() { DecodeTexture(request); });
+
+		return result;
+	}
+
+	bool IsTextureReady(const Texture& texture)
+	{
+		if (!s_Data)
+			return true;
+
+		std::scoped_lock lock(s_Data->Mutex);
+		return !s_Data->Requests.contains(texture.Handle);
+	}
+
+	// Caller must hold s_Data->Mutex. Returns the number of bytes submitted.
+	static uint64_t UploadRows(StreamingRequest& request, uint64_t byteBudget)
+	{
+		const Texture& texture = request.Target;
+		const uint64_t rowSize = (uint64_t)texture.Width * 4;
+
+		// Always make progress, even when a single row is over budget
+		uint32_t rows = (uint32_t)std::clamp<uint64_t>(byteBudget / rowSize, 1, texture.Height - request.RowsUploaded);
+		const uint64_t offset = request.RowsUploaded * rowSize;
+
+		if (request.StagingIndex >= 0)
+		{
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, s_Data->StagingBuffers[request.StagingIndex].Handle);
+			glTextureSubImage2D(texture.Handle, 0, 0, request.RowsUploaded, texture.Width, rows, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)(uintptr_t)offset);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		}
+		else
+		{
+			// Too large for a staging buffer, let the driver copy straight from the decoded image
+			glTextureSubImage2D(texture.Handle, 0, 0, request.RowsUploaded, texture.Width, rows, GL_RGBA, GL_UNSIGNED_BYTE, request.Pixels + offset);
+		}
+
+		request.RowsUploaded += rows;
+		return rows * rowSize;
+	}
+
+	static bool IsSignaled(GLsync fence)
+	{
+		const GLenum status = glClientWaitSync(fence, 0, 0);
+		return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+	}
+
+	static void ReleaseRequest(StreamingRequest& request)
+	{
+		if (request.StagingIndex >= 0)
+			s_Data->StagingBuffers[request.StagingIndex].InUse = false;
+
+		stbi_image_free(request.Pixels);
+		request.StagingIndex = -1;
+		request.Pixels = nullptr;
+
+		// A cancelled request's handle may already belong to a newer texture
+		auto it = s_Data->Requests.find(request.Target.Handle);
+		if (it != s_Data->Requests.end() && it->second.get() == &request)
+			s_Data->Requests.erase(it);
+	}
+
+	void ProcessTextureUploads(uint64_t byteBudget)
+	{
+		PROFILE_FUNC();
+
+		if (!s_Data)
+			return;
+
+		std::scoped_lock lock(s_Data->Mutex);
+
+		uint64_t bytesUploaded = 0;
+
+		std::erase_if(s_Data->UploadQueue, [&](const std::shared_ptr<StreamingRequest>& request)
+		{
+			if (!request->Decoded)
+				return false;
+
+			if (!request->Failed && !request->Cancelled && !glIsTexture(request->Target.Handle))
+			{
+				request->Cancelled = true;
+
+				// Copies out of the staging buffer may still be in flight
+				if (request->StagingIndex >= 0 && request->RowsUploaded > 0 && !request->Fence)
+					request->Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			}
+
+			if (request->Failed || request->Cancelled)
+			{
+				// The staging buffer is only handed out again once the GPU is done reading it
+				if (request->Fence)
+				{
+					if (!IsSignaled(request->Fence))
+						return false;
+
+					glDeleteSync(request->Fence);
+					request->Fence = nullptr;
+				}
+
+				ReleaseRequest(*request);
+				return true;
+			}
+
+			if (request->CurrentState == StreamingRequest::State::Finishing)
+			{
+				if (!IsSignaled(request->Fence))
+					return false;
+
+				glDeleteSync(request->Fence);
+				request->Fence = nullptr;
+
+				ReleaseRequest(*request);
+				s_Data->TotalTexturesLoaded++;
+				return true;
+			}
+
+			if (bytesUploaded >= byteBudget)
+				return false;
+
+			// A staging buffer may have freed up since the decode finished
+			const uint64_t size = (uint64_t)request->Target.Width * request->Target.Height * 4;
+			if (request->StagingIndex < 0 && request->RowsUploaded == 0)
+			{
+				request->StagingIndex = AcquireStagingBuffer(size);
+				if (request->StagingIndex >= 0)
+				{
+					memcpy(s_Data->StagingBuffers[request->StagingIndex].Data, request->Pixels, size);
+					stbi_image_free(request->Pixels);
+					request->Pixels = nullptr;
+				}
+			}
+
+			bytesUploaded += UploadRows(*request, byteBudget - bytesUploaded);
+
+			if (request->RowsUploaded == request->Target.Height)
+			{
+				glGenerateTextureMipmap(request->Target.Handle);
+				request->Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+				request->CurrentState = StreamingRequest::State::Finishing;
+			}
+
+			return false;
+		});
+
+		s_Data->BytesUploadedLastFrame = bytesUploaded;
+	}
+
+	void ShutdownTextureStreaming()
+	{
+		PROFILE_FUNC();
+
+		if (!s_Data)
+			return;
+
+		// Workers write straight into the mapped staging memory
+		Core::JobSystem::Wait(s_Data->DecodeJobs);
+
+		for (const std::shared_ptr<StreamingRequest>& request : s_Data->UploadQueue)
+		{
+			if (request->Fence)
+				glDeleteSync(request->Fence);
+			stbi_image_free(request->Pixels);
+		}
+
+		for (StagingBuffer& staging : s_Data->StagingBuffers)
+		{
+			glUnmapNamedBuffer(staging.Handle);
+			glDeleteBuffers(1, &staging.Handle);
+		}
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	TextureStreamingStats GetTextureStreamingStats()
+	{
+		TextureStreamingStats stats;
+		if (!s_Data)
+			return stats;
+
+		std::scoped_lock lock(s_Data->Mutex);
+
+		for (const std::shared_ptr<StreamingRequest>& request : s_Data->UploadQueue)
+		{
+			if (!request->Decoded)
+				stats.Decoding++;
+			else if (request->CurrentState == StreamingRequest::State::Finishing || request->Cancelled)
+				stats.Finishing++;
+			else
+				stats.Uploading++;
+		}
+
+		stats.BytesUploadedLastFrame = s_Data->BytesUploadedLastFrame;
+		stats.TotalTexturesLoaded = s_Data->TotalTexturesLoaded;
+		return stats;
+	}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Renderer.h"
+
+#include <filesystem>
+
+namespace Renderer {
+
+	struct TextureStreamingStats
+	{
+		uint32_t Decoding = 0;  // Waiting on or running on a job system worker
+		uint32_t Uploading = 0; // Decoded, rows still being copied into the texture
+		uint32_t Finishing = 0; // Fully submitted, waiting on the GPU fence
+		uint64_t BytesUploadedLastFrame = 0;
+		uint64_t TotalTexturesLoaded = 0;
+	};
+
+	// Returns a texture with its final size and a transparent placeholder right away.
+	// The file is decoded on job system workers into persistent-mapped staging
+	// buffers and copied in by ProcessTextureUploads over the following frames.
+	// Must be called on the thread that owns the GL context.
+	Texture LoadTextureAsync(const std::filesystem::path& path);
+
+	// True once the texture's data (and mips) have landed on the GPU. Safe to call from any thread.
+	bool IsTextureReady(const Texture& texture);
+
+	// Issues at most byteBudget bytes of texture uploads and retires finished ones. Call once per frame on the GL thread.
+	void ProcessTextureUploads(uint64_t byteBudget);
+
+	// Waits for outstanding decodes and releases the staging buffers. GL thread only.
+	void ShutdownTextureStreaming();
+
+	TextureStreamingStats GetTextureStreamingStats();
+
+}
@@ -0,0 +1,116 @@
+#include "UniformBuffers.h"
+
+#include "StreamingBuffer.h"
+
+#include "Core/Debug/Profiler.h"
+
+#include <cstring>
+
+namespace Renderer {
+
+	// DrawData entries are reserved this many at a time, a full chunk is replaced by a fresh
+	// one and the draws issued so far keep reading the old binding
+	static constexpr uint32_t DrawDataChunkSize = 1024;
+
+	enum FallbackBuffer { FallbackFrame = 0, FallbackView, FallbackPostProcess, FallbackDrawData, FallbackCount };
+
+	struct UniformBuffersData
+	{
+		StreamingAllocation DrawDataChunk;
+		uint32_t ChunkCount = 0; // Entries used in DrawDataChunk
+		uint32_t DrawCount = 0;
+
+		// Used when the streaming buffer has no room, updated with glNamedBufferSubData
+		GLuint FallbackBuffers[FallbackCount] = {};
+	};
+
+	static UniformBuffersData s_Data;
+
+	static GLuint GetFallbackBuffer(FallbackBuffer which, GLsizeiptr size)
+	{
+		GLuint& buffer = s_Data.FallbackBuffers[which];
+		if (!buffer)
+		{
+			glCreateBuffers(1, &buffer);
+			glNamedBufferStorage(buffer, size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+		}
+		return buffer;
+	}
+
+	template<typename T>
+	static void UploadUniforms(const T& uniforms, GLuint binding, FallbackBuffer fallback)
+	{
+		if (StreamingAllocation allocation = GetStreamingBuffer().AllocateUniform(sizeof(T)))
+		{
+			std::memcpy(allocation.Data, &uniforms, sizeof(T));
+			glBindBufferRange(GL_UNIFORM_BUFFER, binding, allocation.Buffer, allocation.Offset, allocation.Size);
+			return;
+		}
+
+		GLuint buffer = GetFallbackBuffer(fallback, sizeof(T));
+		glNamedBufferSubData(buffer, 0, sizeof(T), &uniforms);
+		glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+	}
+
+	static void BeginDrawDataChunk()
+	{
+		s_Data.ChunkCount = 0;
+		s_Data.DrawDataChunk = GetStreamingBuffer().AllocateStorage(DrawDataChunkSize * sizeof(DrawData));
+
+		if (s_Data.DrawDataChunk)
+			glBindBufferRange(GL_SHADER_STORAGE_BUFFER, StorageBindingDrawData, s_Data.DrawDataChunk.Buffer, s_Data.DrawDataChunk.Offset, s_Data.DrawDataChunk.Size);
+		else
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, StorageBindingDrawData, GetFallbackBuffer(FallbackDrawData, DrawDataChunkSize * sizeof(DrawData)));
+	}
+
+	void BeginFrameUniforms(const FrameUniforms& uniforms)
+	{
+		PROFILE_FUNC();
+
+		UploadUniforms(uniforms, UniformBindingFrame, FallbackFrame);
+		UploadUniforms(ViewUniforms(), UniformBindingView, FallbackView);
+
+		s_Data.DrawCount = 0;
+		BeginDrawDataChunk();
+	}
+
+	void SetViewUniforms(const ViewUniforms& uniforms)
+	{
+		UploadUniforms(uniforms, UniformBindingView, FallbackView);
+	}
+
+	void SetPostProcessUniforms(const PostProcessUniforms& uniforms)
+	{
+		UploadUniforms(uniforms, UniformBindingPostProcess, FallbackPostProcess);
+	}
+
+	uint32_t PushDrawData(const DrawData& data)
+	{
+		if (s_Data.ChunkCount == DrawDataChunkSize)
+			BeginDrawDataChunk();
+
+		const uint32_t index = s_Data.ChunkCount++;
+		s_Data.DrawCount++;
+
+		// Entries are never rewritten within a frame, writing through the coherent mapping
+		// before the draw is issued is enough
+		if (s_Data.DrawDataChunk)
+			std::memcpy((DrawData*)s_Data.DrawDataChunk.Data + index, &data, sizeof(DrawData));
+		else
+			glNamedBufferSubData(s_Data.FallbackBuffers[FallbackDrawData], index * sizeof(DrawData), sizeof(DrawData), &data);
+
+		return index;
+	}
+
+	uint32_t GetDrawDataCount()
+	{
+		return s_Data.DrawCount;
+	}
+
+	void ShutdownUniformBuffers()
+	{
+		glDeleteBuffers(FallbackCount, s_Data.FallbackBuffers);
+		s_Data = {};
+	}
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <stdint.h>
+
+namespace Renderer {
+
+	// Reserved binding points, mirrored in Resources/Shaders/Common.glslh
+	enum UniformBinding : GLuint
+	{
+		UniformBindingFrame = 0,
+		UniformBindingView = 1,
+		UniformBindingPostProcess = 2
+	};
+
+	enum StorageBinding : GLuint
+	{
+		StorageBindingDrawData = 0
+	};
+
+	// std140, FrameData in Common.glslh
+	struct FrameUniforms
+	{
+		float Time = 0.0f;
+		float DeltaTime = 0.0f;
+		uint32_t FrameIndex = 0;
+		float Padding0 = 0.0f;
+		glm::vec2 Resolution = glm::vec2(0.0f);
+		glm::vec2 InverseResolution = glm::vec2(0.0f);
+	};
+	static_assert(sizeof(FrameUniforms) == 32);
+
+	// std140, ViewData in Common.glslh
+	struct ViewUniforms
+	{
+		glm::mat4 View = glm::mat4(1.0f);
+		glm::mat4 Projection = glm::mat4(1.0f);
+		glm::mat4 ViewProjection = glm::mat4(1.0f);
+	};
+	static_assert(sizeof(ViewUniforms) == 192);
+
+	// std140, PostProcessData in Common.glslh
+	struct PostProcessUniforms
+	{
+		float Exposure = 1.0f;
+		float BloomIntensity = 0.0f; // 0 without bloom
+		float BloomThreshold = 1.0f;
+		uint32_t BloomPrefilter = 0; // Bool, the first downsample keeps only what's above the threshold
+		uint32_t Tonemap = 0;        // Bool
+		float Padding0[3] = {};
+	};
+	static_assert(sizeof(PostProcessUniforms) == 32);
+
+	// std430, one entry of the DrawData SSBO in Common.glslh. Params is free for the shader to interpret.
+	struct DrawData
+	{
+		glm::mat4 Transform = glm::mat4(1.0f);
+		glm::vec4 Params = glm::vec4(0.0f);
+	};
+	static_assert(sizeof(DrawData) == 80);
+
+	// The blocks live in the streaming buffer and are bound with glBindBufferRange, so
+	// nothing here touches a program. GL thread, between the streaming buffer's BeginFrame
+	// and EndFrame.
+
+	// Uploads the frame block and binds the first DrawData entries. Application calls it
+	// once per frame before the layers render, and also resets the view block to identity.
+	void BeginFrameUniforms(const FrameUniforms& uniforms);
+
+	// Uploads a view block and binds it, draws issued after this see it
+	void SetViewUniforms(const ViewUniforms& uniforms);
+
+	// Same for the post-process block, per dispatch
+	void SetPostProcessUniforms(const PostProcessUniforms& uniforms);
+
+	// Writes an entry of the DrawData SSBO and returns its index. Shaders read it with
+	// gl_BaseInstance, so pass the index as the base instance of the draw.
+	uint32_t PushDrawData(const DrawData& data);
+
+	// Entries pushed this frame
+	uint32_t GetDrawDataCount();
+
+	void ShutdownUniformBuffers();
+
+}
@@ -0,0 +1,318 @@
+#include "TransformBatch.h"
+
+#include "Debug/Profiler.h"
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+#if TRANSFORM_BATCH_AVX2
+#include <immintrin.h>
+#endif
+
+namespace Core {
+
+	static constexpr uint32_t Width = 8;
+
+	uint32_t TransformBatch::Add(const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale, uint32_t parent)
+	{
+		// Whole blocks of identity transforms, so the kernels never need a tail
+		if (m_Count % Width == 0)
+		{
+			const size_t size = m_Count + Width;
+			for (std::vector<float>& component : m_Translation)
+				component.resize(size, 0.0f);
+			for (std::vector<float>& component : m_Rotation)
+				component.resize(size, 0.0f);
+			m_Rotation[3].resize(size, 1.0f);
+			for (std::vector<float>& component : m_Scale)
+				component.resize(size, 1.0f);
+			m_Parent.resize(size, 0);
+			for (std::vector<float>& element : m_World)
+				element.resize(size, 0.0f);
+		}
+
+		const uint32_t index = m_Count++;
+		SetTranslation(index, translation);
+		SetRotation(index, rotation);
+		SetScale(index, scale);
+		m_Parent[index] = parent;
+		m_MaxParent = std::max(m_MaxParent, parent);
+		return index;
+	}
+
+	void TransformBatch::Clear()
+	{
+		m_Count = 0;
+		for (std::vector<float>& component : m_Translation)
+			component.clear();
+		for (std::vector<float>& component : m_Rotation)
+			component.clear();
+		for (std::vector<float>& component : m_Scale)
+			component.clear();
+		m_Parent.clear();
+		m_MaxParent = 0;
+		for (std::vector<float>& element : m_World)
+			element.clear();
+	}
+
+	void TransformBatch::SetTranslation(uint32_t index, const glm::vec3& translation)
+	{
+		m_Translation[0][index] = translation.x;
+		m_Translation[1][index] = translation.y;
+		m_Translation[2][index] = translation.z;
+	}
+
+	void TransformBatch::SetRotation(uint32_t index, const glm::quat& rotation)
+	{
+		m_Rotation[0][index] = rotation.x;
+		m_Rotation[1][index] = rotation.y;
+		m_Rotation[2][index] = rotation.z;
+		m_Rotation[3][index] = rotation.w;
+	}
+
+	void TransformBatch::SetScale(uint32_t index, const glm::vec3& scale)
+	{
+		m_Scale[0][index] = scale.x;
+		m_Scale[1][index] = scale.y;
+		m_Scale[2][index] = scale.z;
+	}
+
+	void TransformBatch::Update(const TransformBatch* parents, TransformKernel kernel)
+	{
+		PROFILE_FUNC();
+
+		// The kernels would read parent rows from the very blocks they are writing
+		if (parents == this)
+		{
+			std::cerr << "TransformBatch::Update: a batch can't be its own parent batch, not updated" << std::endl;
+			return;
+		}
+
+		// The kernels read parents' world matrices at the clamped parent index, which needs one
+		if (parents && parents->m_Count == 0)
+		{
+			static bool s_Warned = false;
+			if (m_Count > 0 && !s_Warned)
+			{
+				std::cerr << "TransformBatch::Update: parent batch is empty, updating without parents" << std::endl;
+				s_Warned = true;
+			}
+			parents = nullptr;
+		}
+
+		// The kernels clamp each index as they read it, the stored ones are left alone
+		static bool s_WarnedRange = false;
+		if (parents && m_MaxParent >= parents->m_Count && !s_WarnedRange)
+		{
+			std::cerr << "TransformBatch::Update: parent index " << m_MaxParent << " is past the parent batch's " << parents->m_Count << " transforms, clamping" << std::endl;
+			s_WarnedRange = true;
+		}
+
+#if TRANSFORM_BATCH_AVX2
+		if (kernel == TransformKernel::AVX2)
+		{
+			UpdateAVX2(parents);
+			return;
+		}
+#endif
+
+		UpdateScalar(parents, 0, m_Count);
+	}
+
+	void TransformBatch::Pack(PackedTransform* out, TransformKernel kernel) const
+	{
+		PROFILE_FUNC();
+
+#if TRANSFORM_BATCH_AVX2
+		if (kernel == TransformKernel::AVX2)
+		{
+			PackAVX2(out);
+			return;
+		}
+#endif
+
+		PackScalar(out, 0, m_Count);
+	}
+
+	glm::mat4 TransformBatch::GetWorldMatrix(uint32_t index) const
+	{
+		glm::mat4 result(1.0f);
+		for (int row = 0; row < 3; row++)
+		{
+			for (int column = 0; column < 4; column++)
+				result[column][row] = m_World[row * 4 + column][index];
+		}
+		return result;
+	}
+
+	void TransformBatch::UpdateScalar(const TransformBatch* parents, uint32_t begin, uint32_t end)
+	{
+		for (uint32_t i = begin; i < end; i++)
+		{
+			const float x = m_Rotation[0][i], y = m_Rotation[1][i], z = m_Rotation[2][i], w = m_Rotation[3][i];
+			const float xx = x * x * 2.0f, yy = y * y * 2.0f, zz = z * z * 2.0f;
+			const float xy = x * y * 2.0f, xz = x * z * 2.0f, yz = y * z * 2.0f;
+			const float wx = w * x * 2.0f, wy = w * y * 2.0f, wz = w * z * 2.0f;
+
+			const float sx = m_Scale[0][i], sy = m_Scale[1][i], sz = m_Scale[2][i];
+
+			// Translation * rotation * scale
+			const float local[12] = {
+				(1.0f - yy - zz) * sx, (xy - wz) * sy,        (xz + wy) * sz,        m_Translation[0][i],
+				(xy + wz) * sx,        (1.0f - xx - zz) * sy, (yz - wx) * sz,        m_Translation[1][i],
+				(xz - wy) * sx,        (yz + wx) * sy,        (1.0f - xx - yy) * sz, m_Translation[2][i]
+			};
+
+			if (!parents)
+			{
+				for (int element = 0; element < 12; element++)
+					m_World[element][i] = local[element];
+				continue;
+			}
+
+			const uint32_t parent = std::min(m_Parent[i], parents->m_Count - 1);
+			for (int row = 0; row < 3; row++)
+			{
+				const float p0 = parents->m_World[row * 4 + 0][parent];
+				const float p1 = parents->m_World[row * 4 + 1][parent];
+				const float p2 = parents->m_World[row * 4 + 2][parent];
+				const float p3 = parents->m_World[row * 4 + 3][parent];
+
+				for (int column = 0; column < 4; column++)
+					m_World[row * 4 + column][i] = p0 * local[column] + p1 * local[4 + column] + p2 * local[8 + column] + (column == 3 ? p3 : 0.0f);
+			}
+		}
+	}
+
+	void TransformBatch::PackScalar(PackedTransform* out, uint32_t begin, uint32_t end) const
+	{
+		for (uint32_t i = begin; i < end; i++)
+		{
+			for (int element = 0; element < 12; element++)
+				out[i].Rows[element / 4][element % 4] = glm::packHalf1x16(m_World[element][i]);
+		}
+	}
+
+#if TRANSFORM_BATCH_AVX2
+	void TransformBatch::UpdateAVX2(const TransformBatch* parents)
+	{
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256i lastParent = _mm256_set1_epi32(parents ? (int)(parents->m_Count - 1) : 0);
+
+		for (uint32_t i = 0; i < m_Count; i += Width)
+		{
+			const __m256 x = _mm256_loadu_ps(&m_Rotation[0][i]);
+			const __m256 y = _mm256_loadu_ps(&m_Rotation[1][i]);
+			const __m256 z = _mm256_loadu_ps(&m_Rotation[2][i]);
+			const __m256 w = _mm256_loadu_ps(&m_Rotation[3][i]);
+
+			const __m256 x2 = _mm256_add_ps(x, x), y2 = _mm256_add_ps(y, y), z2 = _mm256_add_ps(z, z);
+			const __m256 xx = _mm256_mul_ps(x, x2), yy = _mm256_mul_ps(y, y2), zz = _mm256_mul_ps(z, z2);
+			const __m256 xy = _mm256_mul_ps(x, y2), xz = _mm256_mul_ps(x, z2), yz = _mm256_mul_ps(y, z2);
+			const __m256 wx = _mm256_mul_ps(w, x2), wy = _mm256_mul_ps(w, y2), wz = _mm256_mul_ps(w, z2);
+
+			const __m256 sx = _mm256_loadu_ps(&m_Scale[0][i]);
+			const __m256 sy = _mm256_loadu_ps(&m_Scale[1][i]);
+			const __m256 sz = _mm256_loadu_ps(&m_Scale[2][i]);
+
+			// Translation * rotation * scale, as in UpdateScalar
+			const __m256 local[12] = {
+				_mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(yy, zz)), sx),
+				_mm256_mul_ps(_mm256_sub_ps(xy, wz), sy),
+				_mm256_mul_ps(_mm256_add_ps(xz, wy), sz),
+				_mm256_loadu_ps(&m_Translation[0][i]),
+
+				_mm256_mul_ps(_mm256_add_ps(xy, wz), sx),
+				_mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, zz)), sy),
+				_mm256_mul_ps(_mm256_sub_ps(yz, wx), sz),
+				_mm256_loadu_ps(&m_Translation[1][i]),
+
+				_mm256_mul_ps(_mm256_sub_ps(xz, wy), sx),
+				_mm256_mul_ps(_mm256_add_ps(yz, wx), sy),
+				_mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, yy)), sz),
+				_mm256_loadu_ps(&m_Translation[2][i])
+			};
+
+			if (!parents)
+			{
+				for (int element = 0; element < 12; element++)
+					_mm256_storeu_ps(&m_World[element][i], local[element]);
+				continue;
+			}
+
+			// The 8 parents are anywhere in the parent batch, gather them a row at a time
+			const __m256i parent = _mm256_min_epu32(_mm256_loadu_si256((const __m256i*)&m_Parent[i]), lastParent);
+			for (int row = 0; row < 3; row++)
+			{
+				const __m256 p0 = _mm256_i32gather_ps(parents->m_World[row * 4 + 0].data(), parent, 4);
+				const __m256 p1 = _mm256_i32gather_ps(parents->m_World[row * 4 + 1].data(), parent, 4);
+				const __m256 p2 = _mm256_i32gather_ps(parents->m_World[row * 4 + 2].data(), parent, 4);
+				const __m256 p3 = _mm256_i32gather_ps(parents->m_World[row * 4 + 3].data(), parent, 4);
+
+				for (int column = 0; column < 4; column++)
+				{
+					__m256 value = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p0, local[column]), _mm256_mul_ps(p1, local[4 + column])), _mm256_mul_ps(p2, local[8 + column]));
+					if (column == 3)
+						value = _mm256_add_ps(value, p3);
+					_mm256_storeu_ps(&m_World[row * 4 + column][i], value);
+				}
+			}
+		}
+	}
+
+	void TransformBatch::PackAVX2(PackedTransform* out) const
+	{
+		// out has no padding, the last partial block goes through PackScalar
+		const uint32_t blockEnd = m_Count / Width * Width;
+
+		for (uint32_t i = 0; i < blockEnd; i += Width)
+		{
+			__m128i h[12];
+			for (int element = 0; element < 12; element++)
+				h[element] = _mm256_cvtps_ph(_mm256_loadu_ps(&m_World[element][i]), _MM_FROUND_TO_NEAREST_INT);
+
+			// Transpose elements 0-7 so t[j] holds the first two rows of transform j
+			const __m128i a0 = _mm_unpacklo_epi16(h[0], h[1]), a1 = _mm_unpackhi_epi16(h[0], h[1]);
+			const __m128i a2 = _mm_unpacklo_epi16(h[2], h[3]), a3 = _mm_unpackhi_epi16(h[2], h[3]);
+			const __m128i a4 = _mm_unpacklo_epi16(h[4], h[5]), a5 = _mm_unpackhi_epi16(h[4], h[5]);
+			const __m128i a6 = _mm_unpacklo_epi16(h[6], h[7]), a7 = _mm_unpackhi_epi16(h[6], h[7]);
+
+			const __m128i b0 = _mm_unpacklo_epi32(a0, a2), b1 = _mm_unpackhi_epi32(a0, a2);
+			const __m128i b2 = _mm_unpacklo_epi32(a1, a3), b3 = _mm_unpackhi_epi32(a1, a3);
+			const __m128i b4 = _mm_unpacklo_epi32(a4, a6), b5 = _mm_unpackhi_epi32(a4, a6);
+			const __m128i b6 = _mm_unpacklo_epi32(a5, a7), b7 = _mm_unpackhi_epi32(a5, a7);
+
+			const __m128i t[8] = {
+				_mm_unpacklo_epi64(b0, b4), _mm_unpackhi_epi64(b0, b4),
+				_mm_unpacklo_epi64(b1, b5), _mm_unpackhi_epi64(b1, b5),
+				_mm_unpacklo_epi64(b2, b6), _mm_unpackhi_epi64(b2, b6),
+				_mm_unpacklo_epi64(b3, b7), _mm_unpackhi_epi64(b3, b7)
+			};
+
+			// Elements 8-11, the third row, two transforms per register
+			const __m128i c0 = _mm_unpacklo_epi16(h[8], h[9]), c1 = _mm_unpackhi_epi16(h[8], h[9]);
+			const __m128i c2 = _mm_unpacklo_epi16(h[10], h[11]), c3 = _mm_unpackhi_epi16(h[10], h[11]);
+
+			const __m128i r[4] = {
+				_mm_unpacklo_epi32(c0, c2), _mm_unpackhi_epi32(c0, c2),
+				_mm_unpacklo_epi32(c1, c3), _mm_unpackhi_epi32(c1, c3)
+			};
+
+			for (uint32_t j = 0; j < Width; j++)
+			{
+				PackedTransform& transform = out[i + j];
+				_mm_storeu_si128((__m128i*)transform.Rows[0], t[j]);
+				if (j % 2 == 0)
+					_mm_storel_epi64((__m128i*)transform.Rows[2], r[j / 2]);
+				else
+					_mm_storeh_pd((double*)transform.Rows[2], _mm_castsi128_pd(r[j / 2]));
+			}
+		}
+
+		PackScalar(out, blockEnd, m_Count);
+	}
+#endif
+
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <stdint.h>
+#include <vector>
+
+// Release and Dist build with AVX2 and F16C, MSVC has no macro for F16C but /arch:AVX2 implies it
+#if defined(__AVX2__) && (defined(__F16C__) || defined(_MSC_VER))
+	#define TRANSFORM_BATCH_AVX2 1
+#else
+	#define TRANSFORM_BATCH_AVX2 0
+#endif
+
+namespace Core {
+
+	enum class TransformKernel
+	{
+		Scalar,
+		AVX2 // 8 transforms per iteration, runs the scalar kernels when the build lacks AVX2
+	};
+
+	constexpr TransformKernel DefaultTransformKernel = TRANSFORM_BATCH_AVX2 ? TransformKernel::AVX2 : TransformKernel::Scalar;
+
+	// The rows of an affine 3x4 world matrix in half precision, 24 bytes instead of a mat4's 64.
+	// As instance data it's three vec4 attributes of GL_HALF_FLOAT. Halves hold integers exactly
+	// up to 2048, past that translations lose precision.
+	struct PackedTransform
+	{
+		uint16_t Rows[3][4];
+	};
+	static_assert(sizeof(PackedTransform) == 24);
+
+	// Translation, rotation and scale of many transforms in structure-of-arrays form, so the
+	// kernels load 8 of each component at once. A hierarchy is one batch per depth: every
+	// transform in a batch updated with parents has its parent in that batch, which is
+	// updated first. Not thread-safe.
+	class TransformBatch
+	{
+	public:
+		// parent indexes the batch given to Update, it's ignored when there is none. Update
+		// reports indices past the end of that batch and reads the last parent for them.
+		uint32_t Add(const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale, uint32_t parent = 0);
+		void Clear();
+		uint32_t GetCount() const { return m_Count; }
+
+		void SetTranslation(uint32_t index, const glm::vec3& translation);
+		void SetRotation(uint32_t index, const glm::quat& rotation);
+		void SetScale(uint32_t index, const glm::vec3& scale);
+
+		// Composes each transform's matrix and applies its parent's world matrix when parents is
+		// set and not empty. parents can't be this batch.
+		void Update(const TransformBatch* parents = nullptr, TransformKernel kernel = DefaultTransformKernel);
+		// Writes GetCount world matrices of the last Update
+		void Pack(PackedTransform* out, TransformKernel kernel = DefaultTransformKernel) const;
+
+		glm::mat4 GetWorldMatrix(uint32_t index) const;
+	private:
+		void UpdateScalar(const TransformBatch* parents, uint32_t begin, uint32_t end);
+		void PackScalar(PackedTransform* out, uint32_t begin, uint32_t end) const;
+#if TRANSFORM_BATCH_AVX2
+		void UpdateAVX2(const TransformBatch* parents);
+		void PackAVX2(PackedTransform* out) const;
+#endif
+	private:
+		uint32_t m_Count = 0;
+
+		// Padded to a multiple of 8 with identity transforms whose parent is 0
+		std::vector<float> m_Translation[3];
+		std::vector<float> m_Rotation[4]; // Quaternion x, y, z, w
+		std::vector<float> m_Scale[3];
+		std::vector<uint32_t> m_Parent;
+		uint32_t m_MaxParent = 0; // Of m_Parent, so Update checks the range without a pass
+
+		// Row-major affine 3x4, element r * 4 + c
+		std::vector<float> m_World[12];
+	};
+
+}
@@ -4,6 +4,7 @@
 #include "InputEvents.h"
 
 #include "Debug/Profiler.h"
+#include "Renderer/Renderer.h"
 
 #include <glad/glad.h>
 
@@ -33,9 +34,23 @@ namespace Core {
 		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 		glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
 
+		if (m_Specification.Headless)
+		{
+			glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+			glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+		}
+
 		m_Handle = glfwCreateWindow(m_Specification.Width, m_Specification.Height,
 			m_Specification.Title.c_str(), nullptr, nullptr);
 
+		// No usable EGL driver, fall back to Mesa's software rasterizer
+		if (!m_Handle && m_Specification.Headless)
+		{
+			glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+			m_Handle = glfwCreateWindow(m_Specification.Width, m_Specification.Height,
+				m_Specification.Title.c_str(), nullptr, nullptr);
+		}
+
 		if (!m_Handle)
 		{
 			std::cerr << "Failed to create GLFW window!\n";
@@ -45,7 +60,20 @@ namespace Core {
 		glfwMakeContextCurrent(m_Handle);
 		gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
 
-		glfwSwapInterval(m_Specification.VSync ? 1 : 0);
+		int swapInterval = 0;
+		switch (m_Specification.Present)
+		{
+		case PresentMode::Immediate: swapInterval = 0; break;
+		case PresentMode::VSync:     swapInterval = 1; break;
+		case PresentMode::AdaptiveVSync:
+			// A negative interval enables late swap tearing where the driver supports it
+			swapInterval = glfwExtensionSupported("WGL_EXT_swap_control_tear") || glfwExtensionSupported("GLX_EXT_swap_control_tear") ? -1 : 1;
+			break;
+		}
+		glfwSwapInterval(swapInterval);
+
+		if (m_Specification.Headless)
+			CreateOffscreenFramebuffer();
 
 		glfwSetWindowUserPointer(m_Handle, this);
 
@@ -125,8 +153,35 @@ namespace Core {
 			});
 	}
 
+	void Window::CreateOffscreenFramebuffer()
+	{
+		PROFILE_FUNC();
+
+		glCreateRenderbuffers(2, m_OffscreenRenderbuffers);
+		glNamedRenderbufferStorage(m_OffscreenRenderbuffers[0], GL_RGBA8, m_Specification.Width, m_Specification.Height);
+		glNamedRenderbufferStorage(m_OffscreenRenderbuffers[1], GL_DEPTH24_STENCIL8, m_Specification.Width, m_Specification.Height);
+
+		glCreateFramebuffers(1, &m_OffscreenFramebuffer);
+		glNamedFramebufferRenderbuffer(m_OffscreenFramebuffer, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_OffscreenRenderbuffers[0]);
+		glNamedFramebufferRenderbuffer(m_OffscreenFramebuffer, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_OffscreenRenderbuffers[1]);
+
+		if (glCheckNamedFramebufferStatus(m_OffscreenFramebuffer, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+			std::cerr << "Offscreen framebuffer is not complete!" << std::endl;
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_OffscreenFramebuffer);
+		Renderer::SetBackbuffer(m_OffscreenFramebuffer);
+	}
+
 	void Window::Destroy()
 	{
+		if (m_OffscreenFramebuffer)
+		{
+			Renderer::SetBackbuffer(0);
+			glDeleteFramebuffers(1, &m_OffscreenFramebuffer);
+			glDeleteRenderbuffers(2, m_OffscreenRenderbuffers);
+			m_OffscreenFramebuffer = 0;
+		}
+
 		if (m_Handle)
 			glfwDestroyWindow(m_Handle);
 
@@ -135,6 +190,10 @@ namespace Core {
 
 	void Window::Update()
 	{
+		// Nothing to present, the frame stays in the offscreen framebuffer
+		if (m_Specification.Headless)
+			return;
+
 		glfwSwapBuffers(m_Handle);
 	}
 
@@ -11,13 +11,23 @@
 
 namespace Core {
 
+	enum class PresentMode
+	{
+		Immediate,    // Swap as soon as the frame is done, may tear
+		VSync,        // Wait for vertical blank
+		AdaptiveVSync // VSync while on time, tear instead of waiting a whole refresh when late. Falls back to VSync.
+	};
+
 	struct WindowSpecification
 	{
 		std::string Title;
 		uint32_t Width = 1280;
 		uint32_t Height = 720;
 		bool IsResizeable = true;
-		bool VSync = false;
+		PresentMode Present = PresentMode::Immediate;
+		// Invisible window with an EGL or OSMesa context, rendering into an offscreen
+		// framebuffer (see Renderer::GetBackbuffer). Needs GLFW initialized on its null platform.
+		bool Headless = false;
 
 		using EventCallbackFn = std::function<void(Event&)>;
 		EventCallbackFn EventCallback;
@@ -48,11 +58,17 @@ namespace Core {
 
 		void Maximize();
 		void CenterWindow();
+	private:
+		void CreateOffscreenFramebuffer();
 	private:
 		WindowSpecification m_Specification;
 
 		GLFWwindow* m_Handle = nullptr;
 
+		// Headless only
+		uint32_t m_OffscreenFramebuffer = 0;
+		uint32_t m_OffscreenRenderbuffers[2] = {};
+
 	};
 
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 include "./vendor/premake_customization/solution_items.lua"
 include "Dependencies.lua"
 
+newoption {
+	trigger = "memory-tracking",
+	description = "Hook global operator new/delete to count allocations and report them to Tracy"
+}
+
 workspace "Engine"
 	configurations { "Debug", "Debug-AS", "Release", "Dist" }
 	startproject "App"
@@ -53,6 +58,9 @@ workspace "Engine"
 		symbols "Off"
 		defines { "DIST" }
 
+	filter "options:memory-tracking"
+		defines { "ENABLE_MEMORY_TRACKING=1" }
+
 	filter "system:windows"
 		buildoptions { "/EHsc", "/Zc:preprocessor", "/Zc:__cplusplus" }
 		defines { "PLATFORM_WINDOWS" }
@@ -86,6 +94,7 @@ group "Core"
 group ""
 
 group "Tools"
+	include "Benchmark"
 group ""
 
 group "Runtime"